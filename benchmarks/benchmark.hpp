@@ -0,0 +1,392 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: benchmark.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines a small harness for timing and reporting benchmarks
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_BENCHMARK_HPP
+#define WILT_BENCHMARK_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+  //! @brief         prevents the compiler from optimizing away a value
+  //! @param[in]     value - the value that must be computed
+  template <class T>
+  inline void doNotOptimize(const T& value)
+  {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+  }
+
+  //! @brief         prevents the compiler from assuming memory is unchanged
+  inline void clobberMemory()
+  {
+#if defined(__GNUC__)
+    asm volatile("" : : : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_acq_rel);
+#endif
+  }
+
+  // The `State` class is given to each benchmark run. The benchmark does its
+  // setup, then repeats the work being measured for as long as keepRunning()
+  // returns true. Only the time spent in that loop is measured.
+  class State
+  {
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // TYPE DEFINITIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    using clock = std::chrono::steady_clock;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    // PRIVATE MEMBERS
+    ////////////////////////////////////////////////////////////////////////////
+
+    std::size_t iterations_;
+    std::size_t count_;
+    std::int64_t bytes_;
+    std::int64_t items_;
+    clock::time_point start_;
+    clock::time_point end_;
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // CONSTRUCTORS
+    ////////////////////////////////////////////////////////////////////////////
+
+    explicit State(std::size_t iterations)
+      : iterations_(iterations),
+        count_(0),
+        bytes_(0),
+        items_(0),
+        start_(),
+        end_()
+    {
+
+    }
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // QUERY FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Gets the number of times the measured work is repeated
+    std::size_t iterations() const { return iterations_; }
+
+    // Gets the bytes and items processed by each repetition
+    std::int64_t bytesProcessed() const { return bytes_; }
+    std::int64_t itemsProcessed() const { return items_; }
+
+    // Gets the measured time in nanoseconds
+    double elapsed() const { return std::chrono::duration<double, std::nano>(end_ - start_).count(); }
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // ACCESS FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Starts the timer on the first call and stops it on the last, which is
+    // the call that returns false
+    bool keepRunning()
+    {
+      if (count_ == 0)
+        start_ = clock::now();
+      if (count_ == iterations_)
+      {
+        end_ = clock::now();
+        return false;
+      }
+
+      ++count_;
+      return true;
+    }
+
+    // Sets the bytes and items processed by each repetition, which are used to
+    // report throughput
+    void setBytesProcessed(std::int64_t bytes) { bytes_ = bytes; }
+    void setItemsProcessed(std::int64_t items) { items_ = items; }
+
+  }; // class State
+
+  // A single timed run of a benchmark
+  struct Result
+  {
+    std::string name;
+    std::size_t repetition;
+    std::size_t iterations;
+    double time;            // nanoseconds per iteration
+    double bytesPerSecond;
+    double itemsPerSecond;
+  };
+
+  // The settings for a benchmark run, as set from the command line
+  struct Options
+  {
+    std::string filter = ".*";
+    double minTime = 0.05;
+    std::size_t repetitions = 1;
+    std::string json;
+    bool list = false;
+  };
+
+namespace detail
+{
+  struct Benchmark
+  {
+    std::string name;
+    std::function<void(State&)> func;
+  };
+
+  inline std::vector<Benchmark>& registry()
+  {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+  }
+
+  inline Result measure(const Benchmark& benchmark, std::size_t iterations, std::size_t repetition)
+  {
+    State state(iterations);
+    benchmark.func(state);
+
+    const double seconds = state.elapsed() / 1e9;
+    Result result;
+    result.name = benchmark.name;
+    result.repetition = repetition;
+    result.iterations = iterations;
+    result.time = state.elapsed() / (double)iterations;
+    result.bytesPerSecond = seconds > 0 ? (double)state.bytesProcessed() * iterations / seconds : 0;
+    result.itemsPerSecond = seconds > 0 ? (double)state.itemsProcessed() * iterations / seconds : 0;
+    return result;
+  }
+
+  // Finds the number of iterations that take at least 'minTime' seconds.
+  inline std::size_t calibrate(const Benchmark& benchmark, double minTime)
+  {
+    std::size_t iterations = 1;
+    while (true)
+    {
+      const Result result = measure(benchmark, iterations, 0);
+      const double seconds = result.time * iterations / 1e9;
+      if (seconds >= minTime || iterations >= 1000000000)
+        return iterations;
+
+      const double scale = seconds > 0 ? minTime * 1.4 / seconds : 10.0;
+      iterations = std::max(iterations + 1, (std::size_t)(iterations * std::min(scale, 10.0)));
+    }
+  }
+
+  // Formats a rate with binary prefixes for bytes and decimal prefixes for
+  // everything else.
+  inline std::string formatRate(double rate, bool bytes)
+  {
+    const char* binary[] = { "", "Ki", "Mi", "Gi", "Ti" };
+    const char* decimal[] = { "", "k", "M", "G", "T" };
+    const double base = bytes ? 1024.0 : 1000.0;
+
+    int p = 0;
+    for (; rate >= base && p < 4; ++p)
+      rate /= base;
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%8.2f %s%s/s", rate, bytes ? binary[p] : decimal[p], bytes ? "B" : "items");
+    return buffer;
+  }
+
+  inline void writeJson(std::ostream& out, const std::vector<Result>& results)
+  {
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n";
+    out << "  \"context\": {\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#if defined(NDEBUG)
+    out << "    \"library_build_type\": \"release\"\n";
+#else
+    out << "    \"library_build_type\": \"debug\"\n";
+#endif
+    out << "  },\n";
+    out << "  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      const Result& r = results[i];
+      out << (i == 0 ? "\n" : ",\n");
+      out << "    {\n";
+      out << "      \"name\": \"" << r.name << "\",\n";
+      out << "      \"run_name\": \"" << r.name << "\",\n";
+      out << "      \"run_type\": \"iteration\",\n";
+      out << "      \"repetition_index\": " << r.repetition << ",\n";
+      out << "      \"iterations\": " << r.iterations << ",\n";
+      out << "      \"real_time\": " << r.time << ",\n";
+      out << "      \"time_unit\": \"ns\",\n";
+      out << "      \"bytes_per_second\": " << r.bytesPerSecond << ",\n";
+      out << "      \"items_per_second\": " << r.itemsPerSecond << "\n";
+      out << "    }";
+    }
+    out << "\n  ]\n}\n";
+  }
+
+  inline Options parseOptions(int argc, char** argv)
+  {
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string arg = argv[i];
+      auto value = [&arg](const char* prefix) -> const char* {
+        const std::size_t length = std::string(prefix).size();
+        return arg.compare(0, length, prefix) == 0 ? arg.c_str() + length : nullptr;
+      };
+
+      if (const char* v = value("--filter="))
+        options.filter = v;
+      else if (const char* v = value("--min_time="))
+        options.minTime = std::stod(v);
+      else if (const char* v = value("--repetitions="))
+        options.repetitions = std::max(1, std::stoi(v));
+      else if (const char* v = value("--json="))
+        options.json = v;
+      else if (arg == "--list")
+        options.list = true;
+      else
+        throw std::invalid_argument("unknown argument: " + arg);
+    }
+    return options;
+  }
+
+} // namespace detail
+
+  //! @brief         registers a benchmark
+  //! @param[in]     name - the unique name of the benchmark
+  //! @param[in]     func - the function that runs it, given a State
+  //! @return        false if a benchmark with that name already exists
+  inline bool add(std::string name, std::function<void(State&)> func)
+  {
+    auto& benchmarks = detail::registry();
+    for (const auto& benchmark : benchmarks)
+      if (benchmark.name == name)
+        return false;
+
+    benchmarks.push_back({ std::move(name), std::move(func) });
+    return true;
+  }
+
+  //! @brief         runs the registered benchmarks that match the options
+  //! @param[in]     options - the settings for the run
+  //! @return        the results of every repetition of every benchmark
+  inline std::vector<Result> run(const Options& options)
+  {
+    const std::regex filter(options.filter);
+    std::vector<Result> results;
+
+    for (const auto& benchmark : detail::registry())
+    {
+      if (!std::regex_search(benchmark.name, filter))
+        continue;
+
+      if (options.list)
+      {
+        std::cout << benchmark.name << std::endl;
+        continue;
+      }
+
+      const std::size_t iterations = detail::calibrate(benchmark, options.minTime);
+      for (std::size_t r = 0; r < options.repetitions; ++r)
+      {
+        Result result = detail::measure(benchmark, iterations, r);
+
+        char time[32];
+        std::snprintf(time, sizeof(time), "%12.1f ns", result.time);
+        std::cout << benchmark.name << std::string(benchmark.name.size() < 48 ? 48 - benchmark.name.size() : 1, ' ')
+                  << time << std::string(4, ' ')
+                  << detail::formatRate(result.bytesPerSecond, true) << std::string(4, ' ')
+                  << detail::formatRate(result.itemsPerSecond, false) << std::endl;
+
+        results.push_back(std::move(result));
+      }
+    }
+
+    return results;
+  }
+
+  //! @brief         runs the registered benchmarks as set from the command line
+  //! @param[in]     argc - the argument count from main()
+  //! @param[in]     argv - the arguments from main()
+  //! @return        the exit code for main()
+  //!
+  //! Accepts --filter=<regex>, --min_time=<seconds>, --repetitions=<n>,
+  //! --json=<file> and --list.
+  inline int main(int argc, char** argv)
+  {
+    try
+    {
+      const Options options = detail::parseOptions(argc, argv);
+      const std::vector<Result> results = run(options);
+
+      if (!options.json.empty())
+      {
+        std::ofstream file(options.json);
+        if (!file)
+          throw std::runtime_error("could not open " + options.json);
+        detail::writeJson(file, results);
+      }
+      return 0;
+    }
+    catch (const std::exception& e)
+    {
+      std::cerr << "error: " << e.what() << std::endl;
+      return 1;
+    }
+  }
+
+} // namespace bench
+
+#endif // !WILT_BENCHMARK_HPP
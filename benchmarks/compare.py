@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+################################################################################
+# FILE: compare.py
+# DATE: 2026-10-18
+# AUTH: Trevor Wilson <kmdreko@gmail.com>
+# DESC: Runs the benchmarks into JSON baselines and compares two of them
+
+################################################################################
+# Copyright (c) 2019 Trevor Wilson
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy 
+# of this software and associated documentation files(the "Software"), to deal
+# in the Software without restriction, including without limitation the rights 
+# to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+# copies of the Software, and to permit persons to whom the Software is 
+# furnished to do so, subject to the following conditions :
+# 
+#   The above copyright notice and this permission notice shall be included in
+#   all copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""Records and compares benchmark baselines.
+
+Usage:
+
+  compare.py run <benchmark-binary> <output.json> [--repetitions=N] [--filter=REGEX] [--min_time=S]
+  compare.py compare <baseline.json> <contender.json> [--threshold=PERCENT] [--filter=REGEX]
+
+'run' runs the benchmark binary with repeated measurements and saves its JSON
+output as a baseline. 'compare' matches the benchmarks of two baselines by name
+and reports the change in their median times. A benchmark is flagged as a
+regression if it slowed down by more than the threshold and the difference is
+larger than the noise of both runs, estimated from their median absolute
+deviations (MAD). The exit code is 1 if any regressions were found.
+"""
+
+import argparse
+import json
+import math
+import re
+import subprocess
+import sys
+
+# scales the MAD to estimate the standard deviation of normally distributed data
+MAD_SCALE = 1.4826
+
+# how many standard errors apart two medians must be to count as different
+SIGNIFICANCE = 3.0
+
+
+def median(values):
+    ordered = sorted(values)
+    n = len(ordered)
+    mid = n // 2
+    return ordered[mid] if n % 2 else (ordered[mid - 1] + ordered[mid]) / 2.0
+
+
+def mad(values):
+    m = median(values)
+    return median([abs(v - m) for v in values])
+
+
+def load_times(path, pattern):
+    """Gets the per-iteration times in nanoseconds of each benchmark run."""
+    scale = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+    with open(path) as file:
+        data = json.load(file)
+
+    times = {}
+    for entry in data.get('benchmarks', []):
+        if entry.get('run_type', 'iteration') != 'iteration':
+            continue
+        name = entry.get('run_name', entry['name'])
+        if not pattern.search(name):
+            continue
+        time = entry['real_time'] * scale[entry.get('time_unit', 'ns')]
+        times.setdefault(name, []).append(time)
+    return times
+
+
+class Comparison:
+    def __init__(self, name, old, new):
+        self.name = name
+        self.old = median(old)
+        self.new = median(new)
+        self.change = (self.new - self.old) / self.old if self.old > 0 else 0.0
+
+        # the standard error of a median is about 1.25 times that of a mean
+        noise_old = (MAD_SCALE * mad(old)) ** 2 / len(old)
+        noise_new = (MAD_SCALE * mad(new)) ** 2 / len(new)
+        self.noise = 1.2533 * math.sqrt(noise_old + noise_new)
+        self.significant = abs(self.new - self.old) > SIGNIFICANCE * self.noise
+        self.repetitions = min(len(old), len(new))
+
+    def status(self, threshold):
+        if not self.significant or abs(self.change) <= threshold:
+            return ''
+        return 'REGRESSION' if self.change > 0 else 'improvement'
+
+
+def run(args):
+    command = [args.binary, '--json=' + args.output, '--repetitions=%d' % args.repetitions]
+    if args.filter:
+        command.append('--filter=' + args.filter)
+    if args.min_time:
+        command.append('--min_time=' + args.min_time)
+    return subprocess.call(command)
+
+
+def compare(args):
+    pattern = re.compile(args.filter or '.*')
+    threshold = args.threshold / 100.0
+    baseline = load_times(args.baseline, pattern)
+    contender = load_times(args.contender, pattern)
+
+    names = [name for name in baseline if name in contender]
+    if not names:
+        print('no benchmarks in common')
+        return 1
+
+    width = max(len(name) for name in names)
+    print('%-*s  %14s  %14s  %8s  %s' % (width, 'benchmark', 'baseline (ns)', 'contender (ns)', 'change', ''))
+
+    regressions = []
+    for name in names:
+        comparison = Comparison(name, baseline[name], contender[name])
+        status = comparison.status(threshold)
+        if comparison.repetitions < 3 and status:
+            status += ' (few repetitions)'
+        print('%-*s  %14.1f  %14.1f  %+7.1f%%  %s' % (width, name, comparison.old, comparison.new, comparison.change * 100, status))
+        if status.startswith('REGRESSION'):
+            regressions.append(comparison)
+
+    missing = sorted(set(baseline) ^ set(contender))
+    if missing:
+        print('\n%d benchmarks are only in one of the runs' % len(missing))
+
+    if regressions:
+        print('\n%d of %d benchmarks regressed by more than %.1f%%:' % (len(regressions), len(names), args.threshold))
+        for comparison in regressions:
+            print('  %s (%+.1f%%)' % (comparison.name, comparison.change * 100))
+        return 1
+
+    print('\nno regressions above %.1f%% in %d benchmarks' % (args.threshold, len(names)))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Records and compares benchmark baselines.')
+    commands = parser.add_subparsers(dest='command')
+    commands.required = True
+
+    run_parser = commands.add_parser('run', help='run the benchmarks and save a baseline')
+    run_parser.add_argument('binary', help='the benchmark executable')
+    run_parser.add_argument('output', help='the JSON file to write')
+    run_parser.add_argument('--repetitions', type=int, default=10, help='measurements per benchmark (default 10)')
+    run_parser.add_argument('--filter', help='only run benchmarks matching this regex')
+    run_parser.add_argument('--min_time', help='minimum seconds per measurement')
+    run_parser.set_defaults(func=run)
+
+    compare_parser = commands.add_parser('compare', help='compare two baselines')
+    compare_parser.add_argument('baseline', help='the JSON file of the reference run')
+    compare_parser.add_argument('contender', help='the JSON file of the new run')
+    compare_parser.add_argument('--threshold', type=float, default=5.0, help='percent slowdown to flag (default 5)')
+    compare_parser.add_argument('--filter', help='only compare benchmarks matching this regex')
+    compare_parser.set_defaults(func=compare)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
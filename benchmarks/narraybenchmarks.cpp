@@ -0,0 +1,373 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: narraybenchmarks.cpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Benchmarks for the core NArray operations
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Build with optimizations, for example:
+//
+//   g++ -std=c++14 -O3 -DNDEBUG benchmarks/narraybenchmarks.cpp -o narraybenchmarks
+//   ./narraybenchmarks --json=results.json
+//
+// Each benchmark is named "<operation>/<type>/N<dims>/<layout>/<size>", which
+// can be selected with --filter=<regex>.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <type_traits>
+
+#include "benchmark.hpp"
+#include "../src/wilt-narray/narray.hpp"
+
+namespace
+{
+  enum Layout
+  {
+    CONTIGUOUS,
+    TRANSPOSED,
+    FLIPPED,
+    SKIPPED
+  };
+
+  const char* layoutName(Layout layout)
+  {
+    switch (layout)
+    {
+    case CONTIGUOUS: return "contiguous";
+    case TRANSPOSED: return "transposed";
+    case FLIPPED: return "flipped";
+    case SKIPPED: return "skipped";
+    }
+    return "";
+  }
+
+  template <class T> const char* typeName();
+  template <> const char* typeName<std::uint8_t>() { return "u8"; }
+  template <> const char* typeName<std::int32_t>() { return "i32"; }
+  template <> const char* typeName<float>() { return "f32"; }
+  template <> const char* typeName<double>() { return "f64"; }
+
+  std::string sizeName(std::size_t bytes)
+  {
+    if (bytes >= (1 << 20))
+      return std::to_string(bytes >> 20) + "MiB";
+    return std::to_string(bytes >> 10) + "KiB";
+  }
+
+  // Sizes meant to fit in each level of a typical cache hierarchy
+  const std::size_t L1 = std::size_t(16) << 10;
+  const std::size_t L2 = std::size_t(256) << 10;
+  const std::size_t L3 = std::size_t(4) << 20;
+  const std::size_t DRAM = std::size_t(64) << 20;
+
+  template <class T>
+  using sum_type = typename std::conditional<std::is_floating_point<T>::value, T, long long>::type;
+
+  // Gets the sizes of a roughly cube-shaped array of about 'bytes' bytes.
+  template <class T, std::size_t N>
+  wilt::Point<N> shapeOf(std::size_t bytes)
+  {
+    const double count = (double)std::max<std::size_t>(bytes / sizeof(T), 1);
+    const wilt::pos_t side = std::max<wilt::pos_t>(2, (wilt::pos_t)std::llround(std::pow(count, 1.0 / N)));
+
+    wilt::Point<N> sizes;
+    for (std::size_t i = 0; i < N; ++i)
+      sizes[i] = side;
+    return sizes;
+  }
+
+  // Creates an array of about 'bytes' bytes that is accessed with 'layout'.
+  template <class T, std::size_t N>
+  wilt::NArray<T, N> makeArray(std::size_t bytes, Layout layout)
+  {
+    wilt::Point<N> sizes = shapeOf<T, N>(bytes);
+    if (layout == SKIPPED)
+      sizes[N - 1] *= 2;
+
+    wilt::NArray<T, N> arr(sizes, T(1));
+    switch (layout)
+    {
+    case CONTIGUOUS: return arr;
+    case TRANSPOSED: return arr.transpose(0, N - 1);
+    case FLIPPED: return arr.flip(N - 1);
+    case SKIPPED: return arr.skip(N - 1, 2);
+    }
+    return arr;
+  }
+
+  template <class T>
+  sum_type<T> sumBrackets(const T& value)
+  {
+    return value;
+  }
+
+  template <class T, std::size_t N>
+  sum_type<T> sumBrackets(const wilt::NArray<T, N>& arr)
+  {
+    sum_type<T> sum = 0;
+    for (wilt::pos_t x = 0; x < (wilt::pos_t)arr.width(); ++x)
+      sum += sumBrackets(arr[x]);
+    return sum;
+  }
+
+  template <class T>
+  sum_type<T> sumRaw(const T* data, const wilt::pos_t* sizes, const wilt::pos_t* steps, std::size_t n)
+  {
+    sum_type<T> sum = 0;
+    if (n == 1)
+      for (wilt::pos_t i = 0; i < sizes[0]; ++i)
+        sum += data[i * steps[0]];
+    else
+      for (wilt::pos_t i = 0; i < sizes[0]; ++i)
+        sum += sumRaw(data + i * steps[0], sizes + 1, steps + 1, n - 1);
+    return sum;
+  }
+
+  // compress() needs at least one dimension left to reduce
+  template <class T, std::size_t N>
+  void addCompress(Layout, std::size_t, const std::string&, std::false_type)
+  {
+
+  }
+
+  template <class T, std::size_t N>
+  void addCompress(Layout layout, std::size_t bytes, const std::string& suffix, std::true_type)
+  {
+    bench::add("compress" + suffix, [=](bench::State& state) {
+      wilt::NArray<T, N> arr = makeArray<T, N>(bytes, layout);
+      while (state.keepRunning())
+      {
+        wilt::NArray<T, 1> sums = arr.template compress<1>([](const wilt::NArray<T, N - 1>& sub) {
+          return std::accumulate(sub.begin(), sub.end(), T(0));
+        });
+        bench::doNotOptimize(sums.data());
+      }
+      state.setBytesProcessed((std::int64_t)arr.size() * (std::int64_t)sizeof(T));
+      state.setItemsProcessed((std::int64_t)arr.size());
+    });
+  }
+
+  template <class T, std::size_t N>
+  void addKernels(Layout layout, std::size_t bytes)
+  {
+    const std::string suffix = std::string("/") + typeName<T>() + "/N" + std::to_string(N) + "/" + layoutName(layout) + "/" + sizeName(bytes);
+    const std::int64_t size = (std::int64_t)makeArray<T, N>(bytes, layout).size();
+    const std::int64_t elementBytes = size * (std::int64_t)sizeof(T);
+
+    if (layout == CONTIGUOUS)
+    {
+      bench::add("construct" + suffix, [=](bench::State& state) {
+        const wilt::Point<N> sizes = shapeOf<T, N>(bytes);
+        while (state.keepRunning())
+        {
+          wilt::NArray<T, N> arr(sizes, T(1));
+          bench::doNotOptimize(arr.data());
+        }
+        state.setBytesProcessed(elementBytes);
+        state.setItemsProcessed(size);
+      });
+
+      bench::add("transform" + suffix, [=](bench::State& state) {
+        wilt::NArray<T, N> arr = makeArray<T, N>(bytes, layout);
+        while (state.keepRunning())
+        {
+          wilt::NArray<T, N> view = arr.transpose(0, N - 1).flip(0).range(0, 1, arr.width() - 1).skip(N - 1, 2);
+          bench::doNotOptimize(view.data());
+        }
+        state.setItemsProcessed(4);
+      });
+
+      bench::add("reshape" + suffix, [=](bench::State& state) {
+        wilt::NArray<T, N> arr = makeArray<T, N>(bytes, layout);
+        while (state.keepRunning())
+        {
+          wilt::NArray<T, 1> flat = arr.reshape(wilt::Point<1>{ (wilt::pos_t)arr.size() });
+          bench::doNotOptimize(flat.data());
+        }
+        state.setItemsProcessed(1);
+      });
+    }
+
+    bench::add("clone" + suffix, [=](bench::State& state) {
+      wilt::NArray<T, N> arr = makeArray<T, N>(bytes, layout);
+      while (state.keepRunning())
+      {
+        wilt::NArray<T, N> copy = arr.clone();
+        bench::doNotOptimize(copy.data());
+      }
+      state.setBytesProcessed(2 * elementBytes);
+      state.setItemsProcessed(size);
+    });
+
+    bench::add("convertTo" + suffix, [=](bench::State& state) {
+      wilt::NArray<T, N> arr = makeArray<T, N>(bytes, layout);
+      while (state.keepRunning())
+      {
+        wilt::NArray<double, N> converted = arr.template convertTo<double>();
+        bench::doNotOptimize(converted.data());
+      }
+      state.setBytesProcessed(elementBytes + size * (std::int64_t)sizeof(double));
+      state.setItemsProcessed(size);
+    });
+
+    bench::add("add" + suffix, [=](bench::State& state) {
+      wilt::NArray<T, N> a = makeArray<T, N>(bytes, layout);
+      wilt::NArray<T, N> b = makeArray<T, N>(bytes, layout);
+      while (state.keepRunning())
+      {
+        auto sum = a + b;
+        bench::doNotOptimize(sum.data());
+      }
+      state.setBytesProcessed(3 * elementBytes);
+      state.setItemsProcessed(size);
+    });
+
+    bench::add("addAssign" + suffix, [=](bench::State& state) {
+      wilt::NArray<T, N> a = makeArray<T, N>(bytes, layout);
+      wilt::NArray<T, N> b = makeArray<T, N>(bytes, layout);
+      b.setTo(T(0)); // so repeated adds can't overflow
+      while (state.keepRunning())
+      {
+        a += b;
+        bench::clobberMemory();
+      }
+      state.setBytesProcessed(3 * elementBytes);
+      state.setItemsProcessed(size);
+    });
+
+    bench::add("setTo" + suffix, [=](bench::State& state) {
+      wilt::NArray<T, N> arr = makeArray<T, N>(bytes, layout);
+      while (state.keepRunning())
+      {
+        arr.setTo(T(2));
+        bench::clobberMemory();
+      }
+      state.setBytesProcessed(elementBytes);
+      state.setItemsProcessed(size);
+    });
+
+    addCompress<T, N>(layout, bytes, suffix, std::integral_constant<bool, (N > 1)>());
+
+    bench::add("iterator" + suffix, [=](bench::State& state) {
+      wilt::NArray<T, N> arr = makeArray<T, N>(bytes, layout);
+      while (state.keepRunning())
+      {
+        sum_type<T> sum = 0;
+        for (const T& v : arr)
+          sum += v;
+        bench::doNotOptimize(sum);
+      }
+      state.setBytesProcessed(elementBytes);
+      state.setItemsProcessed(size);
+    });
+
+    bench::add("foreach" + suffix, [=](bench::State& state) {
+      wilt::NArray<T, N> arr = makeArray<T, N>(bytes, layout);
+      while (state.keepRunning())
+      {
+        sum_type<T> sum = 0;
+        arr.foreach([&sum](const T& v) { sum += v; });
+        bench::doNotOptimize(sum);
+      }
+      state.setBytesProcessed(elementBytes);
+      state.setItemsProcessed(size);
+    });
+
+    bench::add("brackets" + suffix, [=](bench::State& state) {
+      wilt::NArray<T, N> arr = makeArray<T, N>(bytes, layout);
+      while (state.keepRunning())
+        bench::doNotOptimize(sumBrackets(arr));
+      state.setBytesProcessed(elementBytes);
+      state.setItemsProcessed(size);
+    });
+
+    bench::add("at" + suffix, [=](bench::State& state) {
+      wilt::NArray<T, N> arr = makeArray<T, N>(bytes, layout);
+      while (state.keepRunning())
+      {
+        sum_type<T> sum = 0;
+        wilt::Point<N> pos;
+        for (std::int64_t i = 0; i < size; ++i)
+        {
+          sum += arr.atUnchecked(pos);
+          for (std::size_t d = N; d-- > 0 && ++pos[d] == arr.sizes()[d];)
+            pos[d] = 0;
+        }
+        bench::doNotOptimize(sum);
+      }
+      state.setBytesProcessed(elementBytes);
+      state.setItemsProcessed(size);
+    });
+
+    bench::add("raw" + suffix, [=](bench::State& state) {
+      wilt::NArray<T, N> arr = makeArray<T, N>(bytes, layout);
+      while (state.keepRunning())
+        bench::doNotOptimize(sumRaw<T>(arr.data(), arr.sizes().data(), arr.steps().data(), N));
+      state.setBytesProcessed(elementBytes);
+      state.setItemsProcessed(size);
+    });
+  }
+
+  template <class T>
+  void addLayouts(std::size_t bytes)
+  {
+    for (Layout layout : { CONTIGUOUS, TRANSPOSED, FLIPPED, SKIPPED })
+      addKernels<T, 3>(layout, bytes);
+  }
+
+  void addAll()
+  {
+    // dimensionality
+    addKernels<float, 1>(CONTIGUOUS, L2);
+    addKernels<float, 2>(CONTIGUOUS, L2);
+    addKernels<float, 3>(CONTIGUOUS, L2);
+    addKernels<float, 4>(CONTIGUOUS, L2);
+    addKernels<float, 5>(CONTIGUOUS, L2);
+    addKernels<float, 6>(CONTIGUOUS, L2);
+
+    // layout
+    addLayouts<float>(L2);
+    addLayouts<float>(DRAM);
+
+    // element type
+    addKernels<std::uint8_t, 3>(CONTIGUOUS, L2);
+    addKernels<std::int32_t, 3>(CONTIGUOUS, L2);
+    addKernels<double, 3>(CONTIGUOUS, L2);
+
+    // size
+    addKernels<float, 2>(CONTIGUOUS, L1);
+    addKernels<float, 2>(CONTIGUOUS, L3);
+    addKernels<float, 2>(CONTIGUOUS, DRAM);
+  }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  addAll();
+  return bench::main(argc, argv);
+}
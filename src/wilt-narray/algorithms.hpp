@@ -0,0 +1,1124 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: algorithms.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines algorithms that operate along a dimension of an NArray
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_ALGORITHMS_HPP
+#define WILT_ALGORITHMS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "narray.hpp"
+#include "parallel.hpp"
+
+namespace wilt
+{
+namespace detail
+{
+  // Scans a single lane of 'n' elements, storing the running results in 'dst'.
+  // If 'init' is null, the scan is inclusive, otherwise the scan is exclusive
+  // and starts from '*init'.
+  template <class T, class U, class Operator>
+  void scanLane(const T* src, pos_t srcstep, U* dst, pos_t dststep, pos_t n, const U* init, Operator& op)
+  {
+    if (init)
+    {
+      U acc = *init;
+      for (pos_t i = 0; i < n; ++i, src += srcstep, dst += dststep)
+      {
+        *dst = acc;
+        acc = op(acc, *src);
+      }
+    }
+    else
+    {
+      U acc = *src;
+      *dst = acc;
+      for (pos_t i = 1; i < n; ++i)
+      {
+        src += srcstep;
+        dst += dststep;
+        acc = op(acc, *src);
+        *dst = acc;
+      }
+    }
+  }
+
+  // Scans a single long lane by splitting it into chunks that are scanned
+  // separately, combining the chunk totals, and then applying those totals to
+  // the later chunks. Requires 'op' to be associative.
+  template <class T, class U, class Operator>
+  void scanLaneBlocked(const T* src, pos_t srcstep, U* dst, pos_t dststep, pos_t n, const U* init, Operator& op)
+  {
+    std::size_t chunks = chunkCount(n, PARALLEL_GRAIN);
+    if (chunks <= 1)
+    {
+      scanLane(src, srcstep, dst, dststep, n, init, op);
+      return;
+    }
+
+    // exclusive results are shifted one element forward from the inclusive
+    // results of the same chunk
+    const pos_t shift = init ? 1 : 0;
+
+    std::vector<U> totals(chunks);
+    parallelChunks(n, chunks, [&](std::size_t c, pos_t begin, pos_t end) {
+      const T* s = src + begin * srcstep;
+      U* d = dst + (begin + shift) * dststep;
+      U acc = *s;
+      for (pos_t i = begin; ; )
+      {
+        if (i + shift < n)
+          *d = acc;
+        if (++i == end)
+          break;
+        s += srcstep;
+        d += dststep;
+        acc = op(acc, *s);
+      }
+      totals[c] = acc;
+    });
+
+    std::vector<U> carries(chunks);
+    if (init)
+      carries[0] = *init;
+    for (std::size_t c = 1; c < chunks; ++c)
+      carries[c] = (c == 1 && !init) ? totals[0] : op(carries[c-1], totals[c-1]);
+
+    parallelChunks(n, chunks, [&](std::size_t c, pos_t begin, pos_t end) {
+      if (c == 0 && !init)
+        return;
+
+      U* d = dst + begin * dststep;
+      pos_t i = begin;
+      if (init)
+      {
+        *d = carries[c];
+        d += dststep;
+        ++i;
+      }
+      for (; i < end; ++i, d += dststep)
+        *d = op(carries[c], *d);
+    });
+  }
+
+  // Scans 'src' along 'dim' into 'dst' when 'dim' is the last dimension of
+  // 'dst', meaning each lane is written contiguously. Lanes are run in
+  // parallel, unless there are too few of them to keep the threads busy, in
+  // which case the lanes themselves are split.
+  template <class T, class U, std::size_t N, class Operator>
+  void scanLanes(const NArray<T, N>& src, const NArray<U, N>& dst, std::size_t dim, const U* init, Operator& op)
+  {
+    const pos_t length = src.sizes()[dim];
+    const pos_t lanes = (pos_t)src.size() / length;
+    const pos_t srcstep = src.steps()[dim];
+    const pos_t dststep = dst.steps()[dim];
+    const auto sizes = src.sizes().removed(dim);
+    const auto srcsteps = src.steps().removed(dim);
+    const auto dststeps = dst.steps().removed(dim);
+
+    if (lanes < (pos_t)threadCount() && length >= 2 * PARALLEL_GRAIN)
+    {
+      for (pos_t l = 0; l < lanes; ++l)
+        scanLaneBlocked(src.data() + offsetOf(l, sizes, srcsteps), srcstep, dst.data() + offsetOf(l, sizes, dststeps), dststep, length, init, op);
+      return;
+    }
+
+    parallelFor(lanes, std::max<pos_t>(1, PARALLEL_GRAIN / length), [&](pos_t begin, pos_t end) {
+      for (pos_t l = begin; l < end; ++l)
+        scanLane(src.data() + offsetOf(l, sizes, srcsteps), srcstep, dst.data() + offsetOf(l, sizes, dststeps), dststep, length, init, op);
+    });
+  }
+
+  // Scans 'src' along 'dim' into 'dst' when 'dim' is not the last dimension of
+  // 'dst'. Rather than going lane-by-lane, whole slices are combined with the
+  // previous slice using the element-wise kernels so that the contiguous inner
+  // dimensions are vectorized. The slices are split along another dimension
+  // to run in parallel.
+  template <class T, class U, std::size_t N, class Operator>
+  void scanSlices(const NArray<T, N>& src, const NArray<U, N>& dst, std::size_t dim, const U* init, Operator& op, std::true_type)
+  {
+    const pos_t length = src.sizes()[dim];
+    const pos_t srcstep = src.steps()[dim];
+    const pos_t dststep = dst.steps()[dim];
+    const std::size_t split = (dim == 0) ? 1 : 0;
+    const pos_t splitsize = src.sizes()[split];
+    const pos_t work = (pos_t)src.size() / splitsize;
+
+    parallelFor(splitsize, std::max<pos_t>(1, PARALLEL_GRAIN / work), [&](pos_t begin, pos_t end) {
+      auto sizes = src.sizes();
+      sizes[split] = end - begin;
+      const auto slicesizes = sizes.removed(dim);
+      const auto srcsteps = src.steps().removed(dim);
+      const auto dststeps = dst.steps().removed(dim);
+
+      const T* s = src.data() + begin * src.steps()[split];
+      U* d = dst.data() + begin * dst.steps()[split];
+
+      if (init)
+      {
+        const U& val = *init;
+        detail::unary<N-1>(slicesizes.data(), d, dststeps.data(), [&val](U& u) { u = val; });
+      }
+      else
+      {
+        detail::binary<N-1>(slicesizes.data(), d, dststeps.data(), s, srcsteps.data(), [](U& u, const T& t) { u = t; });
+        s += srcstep;
+      }
+
+      for (pos_t i = 1; i < length; ++i, s += srcstep)
+      {
+        const U* prev = d;
+        d += dststep;
+        detail::ternary<N-1>(slicesizes.data(), d, dststeps.data(), prev, dststeps.data(), s, srcsteps.data(), 
+          [&op](U& u, const U& p, const T& t) { u = op(p, t); });
+      }
+    });
+  }
+
+  template <class T, class U, std::size_t N, class Operator>
+  void scanSlices(const NArray<T, N>&, const NArray<U, N>&, std::size_t, const U*, Operator&, std::false_type)
+  {
+    // unreachable, a 1-dimensional array is always scanned by lanes
+  }
+
+  template <class T, class U, std::size_t N, class Operator>
+  void scan(const NArray<T, N>& src, const NArray<U, N>& dst, std::size_t dim, const U* init, Operator& op)
+  {
+    if (dim == N - 1)
+      scanLanes(src, dst, dim, init, op);
+    else
+      scanSlices(src, dst, dim, init, op, std::integral_constant<bool, (N > 1)>());
+  }
+
+  // The `radix_traits` class determines which element types can be sorted by
+  // their bits rather than by comparison. Enabled types map each value to an
+  // unsigned key that has the same ordering as the value.
+  //
+  // Notes:
+  // - floating point keys from 'toKey()' order -0.0 before 0.0 and place NaNs
+  //   at the ends, 'toStableKey()' treats -0.0 and 0.0 as equal like 'operator<'
+  //   so that stable sorts keep them in their original order
+
+  template <class T, class Enable = void>
+  struct radix_traits
+  {
+    static constexpr bool enabled = false;
+  };
+
+  template <class T>
+  struct radix_traits<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type>
+  {
+    static constexpr bool enabled = true;
+
+    using key_type = typename std::make_unsigned<T>::type;
+
+    static constexpr key_type flip = std::is_signed<T>::value ? key_type(key_type(1) << (sizeof(T) * 8 - 1)) : key_type(0);
+
+    static key_type toKey(T val) noexcept { return key_type(key_type(val) ^ flip); }
+    static T fromKey(key_type key) noexcept { return T(key_type(key ^ flip)); }
+    static key_type toStableKey(T val) noexcept { return toKey(val); }
+  };
+
+  template <class T, class K>
+  struct radix_float_traits
+  {
+    static_assert(sizeof(T) == sizeof(K), "radix_float_traits: key must be the same size");
+
+    static constexpr bool enabled = true;
+
+    using key_type = K;
+
+    static constexpr key_type high = key_type(key_type(1) << (sizeof(K) * 8 - 1));
+
+    static key_type toKey(T val) noexcept
+    {
+      key_type key;
+      std::memcpy(&key, &val, sizeof(T));
+      return (key & high) ? key_type(~key) : key_type(key | high);
+    }
+
+    static T fromKey(key_type key) noexcept
+    {
+      key = (key & high) ? key_type(key & ~high) : key_type(~key);
+      T val;
+      std::memcpy(&val, &key, sizeof(T));
+      return val;
+    }
+
+    static key_type toStableKey(T val) noexcept
+    {
+      return toKey(val == T(0) ? T(0) : val);
+    }
+  };
+
+  template <>
+  struct radix_traits<float> : radix_float_traits<float, std::uint32_t> { };
+
+  template <>
+  struct radix_traits<double> : radix_float_traits<double, std::uint64_t> { };
+
+  // Lanes shorter than this are sorted by comparison even if the element type
+  // could be radix sorted.
+  constexpr pos_t RADIX_THRESHOLD = 256;
+
+  // Sorts 'n' keys with a least-significant-digit radix sort, one byte at a
+  // time. The indices, if provided, are moved along with their keys so that
+  // the sort can be used for argsort. Passes where all keys have the same digit
+  // are skipped. The results always end up in 'keys' and 'indices'.
+  template <class K>
+  void radixSort(K* keys, K* keyscratch, pos_t* indices, pos_t* indexscratch, pos_t n)
+  {
+    K* const keysbegin = keys;
+    pos_t* const indicesbegin = indices;
+
+    for (std::size_t shift = 0; shift < sizeof(K) * 8; shift += 8)
+    {
+      pos_t offsets[256] = { };
+      for (pos_t i = 0; i < n; ++i)
+        ++offsets[(keys[i] >> shift) & 0xFF];
+      if (std::find(std::begin(offsets), std::end(offsets), n) != std::end(offsets))
+        continue;
+
+      pos_t total = 0;
+      for (pos_t& offset : offsets)
+      {
+        pos_t count = offset;
+        offset = total;
+        total += count;
+      }
+
+      if (indices)
+      {
+        for (pos_t i = 0; i < n; ++i)
+        {
+          pos_t j = offsets[(keys[i] >> shift) & 0xFF]++;
+          keyscratch[j] = keys[i];
+          indexscratch[j] = indices[i];
+        }
+        std::swap(indices, indexscratch);
+      }
+      else
+      {
+        for (pos_t i = 0; i < n; ++i)
+          keyscratch[offsets[(keys[i] >> shift) & 0xFF]++] = keys[i];
+      }
+      std::swap(keys, keyscratch);
+    }
+
+    if (keys != keysbegin)
+    {
+      std::copy(keys, keys + n, keysbegin);
+      if (indices)
+        std::copy(indices, indices + n, indicesbegin);
+    }
+  }
+
+  // Sorts each lane along 'dim' by comparison. Contiguous lanes are sorted in
+  // place and strided lanes are gathered into a buffer that is reused for all
+  // lanes handled by the same thread.
+  template <class T, std::size_t N, class Compare>
+  void sortLanes(const NArray<T, N>& arr, std::size_t dim, Compare& comp, std::false_type)
+  {
+    const pos_t length = arr.sizes()[dim];
+    const pos_t lanes = (pos_t)arr.size() / length;
+    const pos_t step = arr.steps()[dim];
+    const auto sizes = arr.sizes().removed(dim);
+    const auto steps = arr.steps().removed(dim);
+
+    parallelFor(lanes, std::max<pos_t>(1, PARALLEL_GRAIN / length), [&](pos_t begin, pos_t end) {
+      std::vector<T> buffer;
+      for (pos_t l = begin; l < end; ++l)
+      {
+        T* lane = arr.data() + offsetOf(l, sizes, steps);
+        if (step == 1)
+        {
+          std::sort(lane, lane + length, comp);
+          continue;
+        }
+
+        buffer.clear();
+        for (pos_t i = 0; i < length; ++i)
+          buffer.push_back(std::move(lane[i * step]));
+        std::sort(buffer.begin(), buffer.end(), comp);
+        for (pos_t i = 0; i < length; ++i)
+          lane[i * step] = std::move(buffer[i]);
+      }
+    });
+  }
+
+  // Sorts each lane along 'dim' using a radix sort on the gathered keys if the
+  // lanes are long enough, the keys are scattered back afterwards.
+  template <class T, std::size_t N, class Compare>
+  void sortLanes(const NArray<T, N>& arr, std::size_t dim, Compare& comp, std::true_type)
+  {
+    using traits = radix_traits<T>;
+    using K = typename traits::key_type;
+
+    const pos_t length = arr.sizes()[dim];
+    if (length < RADIX_THRESHOLD)
+    {
+      sortLanes(arr, dim, comp, std::false_type());
+      return;
+    }
+
+    const pos_t lanes = (pos_t)arr.size() / length;
+    const pos_t step = arr.steps()[dim];
+    const auto sizes = arr.sizes().removed(dim);
+    const auto steps = arr.steps().removed(dim);
+
+    parallelFor(lanes, std::max<pos_t>(1, PARALLEL_GRAIN / length), [&](pos_t begin, pos_t end) {
+      std::vector<K> keys(length);
+      std::vector<K> scratch(length);
+      for (pos_t l = begin; l < end; ++l)
+      {
+        T* lane = arr.data() + offsetOf(l, sizes, steps);
+        for (pos_t i = 0; i < length; ++i)
+          keys[i] = traits::toKey(lane[i * step]);
+        radixSort(keys.data(), scratch.data(), (pos_t*)nullptr, (pos_t*)nullptr, length);
+        for (pos_t i = 0; i < length; ++i)
+          lane[i * step] = traits::fromKey(keys[i]);
+      }
+    });
+  }
+
+  // Stores the stable sorted order of each lane along 'dim' of 'arr' into the
+  // same lane of 'ret' by comparison.
+  template <class T, std::size_t N, class Compare>
+  void argsortLanes(const NArray<T, N>& arr, const NArray<pos_t, N>& ret, std::size_t dim, Compare& comp, std::false_type)
+  {
+    const pos_t length = arr.sizes()[dim];
+    const pos_t lanes = (pos_t)arr.size() / length;
+    const pos_t step = arr.steps()[dim];
+    const pos_t retstep = ret.steps()[dim];
+    const auto sizes = arr.sizes().removed(dim);
+    const auto steps = arr.steps().removed(dim);
+    const auto retsteps = ret.steps().removed(dim);
+
+    parallelFor(lanes, std::max<pos_t>(1, PARALLEL_GRAIN / length), [&](pos_t begin, pos_t end) {
+      std::vector<pos_t> indices(length);
+      for (pos_t l = begin; l < end; ++l)
+      {
+        T* lane = arr.data() + offsetOf(l, sizes, steps);
+        std::iota(indices.begin(), indices.end(), pos_t(0));
+        std::stable_sort(indices.begin(), indices.end(), [&](pos_t a, pos_t b) { return comp(lane[a * step], lane[b * step]); });
+
+        pos_t* retlane = ret.data() + offsetOf(l, sizes, retsteps);
+        for (pos_t i = 0; i < length; ++i)
+          retlane[i * retstep] = indices[i];
+      }
+    });
+  }
+
+  // Stores the stable sorted order of each lane along 'dim' of 'arr' into the
+  // same lane of 'ret' using a radix sort if the lanes are long enough.
+  template <class T, std::size_t N, class Compare>
+  void argsortLanes(const NArray<T, N>& arr, const NArray<pos_t, N>& ret, std::size_t dim, Compare& comp, std::true_type)
+  {
+    using traits = radix_traits<typename std::remove_const<T>::type>;
+    using K = typename traits::key_type;
+
+    const pos_t length = arr.sizes()[dim];
+    if (length < RADIX_THRESHOLD)
+    {
+      argsortLanes(arr, ret, dim, comp, std::false_type());
+      return;
+    }
+
+    const pos_t lanes = (pos_t)arr.size() / length;
+    const pos_t step = arr.steps()[dim];
+    const pos_t retstep = ret.steps()[dim];
+    const auto sizes = arr.sizes().removed(dim);
+    const auto steps = arr.steps().removed(dim);
+    const auto retsteps = ret.steps().removed(dim);
+
+    parallelFor(lanes, std::max<pos_t>(1, PARALLEL_GRAIN / length), [&](pos_t begin, pos_t end) {
+      std::vector<K> keys(length);
+      std::vector<K> keyscratch(length);
+      std::vector<pos_t> indices(length);
+      std::vector<pos_t> indexscratch(length);
+      for (pos_t l = begin; l < end; ++l)
+      {
+        T* lane = arr.data() + offsetOf(l, sizes, steps);
+        for (pos_t i = 0; i < length; ++i)
+          keys[i] = traits::toStableKey(lane[i * step]);
+        std::iota(indices.begin(), indices.end(), pos_t(0));
+        radixSort(keys.data(), keyscratch.data(), indices.data(), indexscratch.data(), length);
+
+        pos_t* retlane = ret.data() + offsetOf(l, sizes, retsteps);
+        for (pos_t i = 0; i < length; ++i)
+          retlane[i * retstep] = indices[i];
+      }
+    });
+  }
+
+  // Selections where fewer than this many elements need to be kept on one side
+  // of the selected element are done with a heap over the lane instead of
+  // partitioning a copy of it.
+  constexpr pos_t HEAP_SELECT_LIMIT = 16;
+
+  // Gets a cleared buffer owned by the calling thread. The buffer keeps its
+  // capacity between uses so that repeated selections do not reallocate.
+  template <class T>
+  std::vector<T>& scratchBuffer()
+  {
+    thread_local std::vector<T> buffer;
+    buffer.clear();
+    return buffer;
+  }
+
+  // Gets the element that would be at position 'k' if the lane were sorted by
+  // 'comp', by keeping the first k+1 elements in a heap. Best when 'k' is small.
+  template <class T, class U, class Compare>
+  U heapSelect(const T* lane, pos_t step, pos_t length, pos_t k, std::vector<U>& heap, Compare comp)
+  {
+    for (pos_t i = 0; i <= k; ++i)
+      heap.push_back(lane[i * step]);
+    std::make_heap(heap.begin(), heap.end(), comp);
+
+    for (pos_t i = k + 1; i < length; ++i)
+    {
+      const T& val = lane[i * step];
+      if (comp(val, heap.front()))
+      {
+        std::pop_heap(heap.begin(), heap.end(), comp);
+        heap.back() = val;
+        std::push_heap(heap.begin(), heap.end(), comp);
+      }
+    }
+
+    return heap.front();
+  }
+
+  // Stores the element at position 'k' of each sorted lane along 'dim' of
+  // 'arr' into the corresponding single element lane of 'ret'.
+  template <class T, class U, std::size_t N>
+  void selectLanes(const NArray<T, N>& arr, const NArray<U, N>& ret, std::size_t dim, pos_t k)
+  {
+    const pos_t length = arr.sizes()[dim];
+    const pos_t lanes = (pos_t)arr.size() / length;
+    const pos_t step = arr.steps()[dim];
+    const auto sizes = arr.sizes().removed(dim);
+    const auto steps = arr.steps().removed(dim);
+    const auto retsteps = ret.steps().removed(dim);
+
+    parallelFor(lanes, std::max<pos_t>(1, PARALLEL_GRAIN / length), [&](pos_t begin, pos_t end) {
+      std::vector<U>& buffer = scratchBuffer<U>();
+      for (pos_t l = begin; l < end; ++l)
+      {
+        const T* lane = arr.data() + offsetOf(l, sizes, steps);
+        U* dst = ret.data() + offsetOf(l, sizes, retsteps);
+
+        buffer.clear();
+        if (k < HEAP_SELECT_LIMIT)
+          *dst = heapSelect(lane, step, length, k, buffer, std::less<U>());
+        else if (length - 1 - k < HEAP_SELECT_LIMIT)
+          *dst = heapSelect(lane, step, length, length - 1 - k, buffer, std::greater<U>());
+        else
+        {
+          for (pos_t i = 0; i < length; ++i)
+            buffer.push_back(lane[i * step]);
+          std::nth_element(buffer.begin(), buffer.begin() + k, buffer.end());
+          *dst = buffer[k];
+        }
+      }
+    });
+  }
+
+  // Stores the 'k' largest elements of each lane along 'dim' of 'arr', and
+  // their positions, into the corresponding lanes of 'values' and 'indices'.
+  // Equal elements are ordered by position so the results do not depend on
+  // which path was taken.
+  template <class T, class U, std::size_t N>
+  void topKLanes(const NArray<T, N>& arr, const NArray<U, N>& values, const NArray<pos_t, N>& indices, std::size_t dim, pos_t k)
+  {
+    using entry = std::pair<U, pos_t>;
+
+    const pos_t length = arr.sizes()[dim];
+    const pos_t lanes = (pos_t)arr.size() / length;
+    const pos_t step = arr.steps()[dim];
+    const pos_t valuestep = values.steps()[dim];
+    const pos_t indexstep = indices.steps()[dim];
+    const auto sizes = arr.sizes().removed(dim);
+    const auto steps = arr.steps().removed(dim);
+    const auto valuesteps = values.steps().removed(dim);
+    const auto indexsteps = indices.steps().removed(dim);
+
+    auto before = [](const entry& a, const entry& b) {
+      return b.first < a.first || (!(a.first < b.first) && a.second < b.second);
+    };
+
+    parallelFor(lanes, std::max<pos_t>(1, PARALLEL_GRAIN / length), [&](pos_t begin, pos_t end) {
+      std::vector<entry>& buffer = scratchBuffer<entry>();
+      for (pos_t l = begin; l < end; ++l)
+      {
+        const T* lane = arr.data() + offsetOf(l, sizes, steps);
+
+        buffer.clear();
+        if (k < HEAP_SELECT_LIMIT)
+        {
+          for (pos_t i = 0; i < k; ++i)
+            buffer.emplace_back(lane[i * step], i);
+          std::make_heap(buffer.begin(), buffer.end(), before);
+          for (pos_t i = k; i < length; ++i)
+          {
+            entry e(lane[i * step], i);
+            if (before(e, buffer.front()))
+            {
+              std::pop_heap(buffer.begin(), buffer.end(), before);
+              buffer.back() = std::move(e);
+              std::push_heap(buffer.begin(), buffer.end(), before);
+            }
+          }
+          std::sort_heap(buffer.begin(), buffer.end(), before);
+        }
+        else
+        {
+          for (pos_t i = 0; i < length; ++i)
+            buffer.emplace_back(lane[i * step], i);
+          std::nth_element(buffer.begin(), buffer.begin() + (k - 1), buffer.end(), before);
+          std::sort(buffer.begin(), buffer.begin() + (k - 1), before);
+        }
+
+        U* valuelane = values.data() + offsetOf(l, sizes, valuesteps);
+        pos_t* indexlane = indices.data() + offsetOf(l, sizes, indexsteps);
+        for (pos_t i = 0; i < k; ++i)
+        {
+          valuelane[i * valuestep] = buffer[i].first;
+          indexlane[i * indexstep] = buffer[i].second;
+        }
+      }
+    });
+  }
+
+  // Calls 'func(data, step, n)' on each run of consecutive elements covering
+  // elements 'begin' to 'end' of the array described by 'data', 'sizes', and
+  // 'steps', counting elements in order. The array should be condensed first so
+  // the runs are as long as possible.
+  template <class T, std::size_t N, class Function>
+  void forRuns(T* data, const Point<N>& sizes, const Point<N>& steps, pos_t begin, pos_t end, Function& func)
+  {
+    const pos_t length = sizes[N-1];
+    const pos_t step = steps[N-1];
+    const auto outersizes = sizes.removed(N-1);
+    const auto outersteps = steps.removed(N-1);
+
+    while (begin < end)
+    {
+      const pos_t col = begin % length;
+      const pos_t n = std::min(length - col, end - begin);
+      func(data + offsetOf(begin / length, outersizes, outersteps) + col * step, step, n);
+      begin += n;
+    }
+  }
+
+  // The number of elements whose bins are computed before any are counted.
+  constexpr pos_t HISTOGRAM_BLOCK = 256;
+
+  // Counts the 'n' elements from 'data' into 'bins' equal width bins over the
+  // range [lo, hi]. Elements outside the range, including NaNs, are counted in
+  // 'counts[bins]' so that the bin computation is branch-free and can be
+  // vectorized separately from the counting.
+  template <class T>
+  void binRun(const T* data, pos_t step, pos_t n, std::size_t* counts, pos_t bins, double lo, double hi)
+  {
+    const double scale = bins / (hi - lo);
+    const double last = double(bins - 1);
+    const double outside = double(bins);
+
+    pos_t index[HISTOGRAM_BLOCK];
+    for (pos_t b = 0; b < n; b += HISTOGRAM_BLOCK)
+    {
+      const T* block = data + b * step;
+      const pos_t m = std::min(HISTOGRAM_BLOCK, n - b);
+      for (pos_t i = 0; i < m; ++i)
+      {
+        const double v = double(block[i * step]);
+        const double t = std::min((v - lo) * scale, last);
+        index[i] = pos_t((v >= lo && v <= hi) ? t : outside);
+      }
+      for (pos_t i = 0; i < m; ++i)
+        ++counts[index[i]];
+    }
+  }
+
+} // namespace detail
+
+  //! @brief         computes the running results of an operation along a
+  //!                dimension, including the current element
+  //! @param[in]     arr - the source array
+  //! @param[in]     dim - the dimension to scan along
+  //! @param[in]     op - function or function object with the signature 
+  //!                T(T, T) or similar, must be associative
+  //! @return        an array of the same size where each element is the result
+  //!                of 'op' on all elements up to and including it along 'dim'
+  //!
+  //! Lanes along 'dim' are scanned in parallel when enabled, and a long lane
+  //! will be split into chunks if there are too few lanes.
+  template <class T, std::size_t N, class Operator>
+  NArray<typename std::remove_const<T>::type, N> inclusiveScan(const NArray<T, N>& arr, std::size_t dim, Operator op)
+  {
+    WILT_NARRAY_TRACE_SCOPE("inclusiveScan", arr);
+    using U = typename std::remove_const<T>::type;
+
+    if (dim >= N)
+      throw std::out_of_range("inclusiveScan(arr, dim, op): dim out of bounds");
+    if (arr.empty())
+      return NArray<U, N>();
+
+    NArray<U, N> ret(arr.sizes());
+    detail::scan(arr, ret, dim, static_cast<const U*>(nullptr), op);
+    return ret;
+  }
+
+  //! @brief         computes the running sums along a dimension, including the
+  //!                current element
+  //! @param[in]     arr - the source array
+  //! @param[in]     dim - the dimension to scan along
+  //! @return        an array of the same size where each element is the sum of
+  //!                all elements up to and including it along 'dim'
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> inclusiveScan(const NArray<T, N>& arr, std::size_t dim)
+  {
+    return inclusiveScan(arr, dim, std::plus<typename std::remove_const<T>::type>());
+  }
+
+  //! @brief         computes the running results of an operation along a
+  //!                dimension, excluding the current element
+  //! @param[in]     arr - the source array
+  //! @param[in]     dim - the dimension to scan along
+  //! @param[in]     init - the initial value, is the first element of each lane
+  //! @param[in]     op - function or function object with the signature 
+  //!                T(T, T) or similar, must be associative
+  //! @return        an array of the same size where each element is the result
+  //!                of 'op' on 'init' and all elements before it along 'dim'
+  //!
+  //! Lanes along 'dim' are scanned in parallel when enabled, and a long lane
+  //! will be split into chunks if there are too few lanes.
+  template <class T, std::size_t N, class Operator>
+  NArray<typename std::remove_const<T>::type, N> exclusiveScan(const NArray<T, N>& arr, std::size_t dim, const typename std::remove_const<T>::type& init, Operator op)
+  {
+    WILT_NARRAY_TRACE_SCOPE("exclusiveScan", arr);
+    using U = typename std::remove_const<T>::type;
+
+    if (dim >= N)
+      throw std::out_of_range("exclusiveScan(arr, dim, init, op): dim out of bounds");
+    if (arr.empty())
+      return NArray<U, N>();
+
+    NArray<U, N> ret(arr.sizes());
+    detail::scan(arr, ret, dim, &init, op);
+    return ret;
+  }
+
+  //! @brief         computes the running sums along a dimension, excluding the
+  //!                current element
+  //! @param[in]     arr - the source array
+  //! @param[in]     dim - the dimension to scan along
+  //! @param[in]     init - the initial value, is the first element of each lane
+  //! @return        an array of the same size where each element is the sum of
+  //!                'init' and all elements before it along 'dim'
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> exclusiveScan(const NArray<T, N>& arr, std::size_t dim, const typename std::remove_const<T>::type& init = typename std::remove_const<T>::type())
+  {
+    return exclusiveScan(arr, dim, init, std::plus<typename std::remove_const<T>::type>());
+  }
+
+  //! @brief         sorts each lane along a dimension in-place
+  //! @param[in]     arr - the array to sort
+  //! @param[in]     dim - the dimension to sort along
+  //!
+  //! Lanes are sorted in parallel when enabled. Integer and floating point
+  //! elements are sorted with a radix sort if the lanes are long enough.
+  //! The sort isn't stable, so equal elements like -0.0 and 0.0 may end up in
+  //! either order. Lanes with NaNs have an unspecified order.
+  template <class T, std::size_t N>
+  void sort(const NArray<T, N>& arr, std::size_t dim)
+  {
+    WILT_NARRAY_TRACE_SCOPE("sort", arr);
+    static_assert(!std::is_const<T>::value, "sort(arr, dim): invalid when element type is const");
+
+    if (dim >= N)
+      throw std::out_of_range("sort(arr, dim): dim out of bounds");
+    if (arr.empty())
+      return;
+
+    std::less<T> comp;
+    detail::sortLanes(arr, dim, comp, std::integral_constant<bool, detail::radix_traits<T>::enabled>());
+  }
+
+  //! @brief         sorts each lane along a dimension in-place
+  //! @param[in]     arr - the array to sort
+  //! @param[in]     dim - the dimension to sort along
+  //! @param[in]     comp - function or function object with the signature
+  //!                bool(T, T) or similar, that returns if the first argument
+  //!                should be ordered before the second
+  //!
+  //! Lanes are sorted in parallel when enabled.
+  template <class T, std::size_t N, class Compare>
+  void sort(const NArray<T, N>& arr, std::size_t dim, Compare comp)
+  {
+    WILT_NARRAY_TRACE_SCOPE("sort", arr);
+    static_assert(!std::is_const<T>::value, "sort(arr, dim, comp): invalid when element type is const");
+
+    if (dim >= N)
+      throw std::out_of_range("sort(arr, dim, comp): dim out of bounds");
+    if (arr.empty())
+      return;
+
+    detail::sortLanes(arr, dim, comp, std::false_type());
+  }
+
+  //! @brief         gets the indexes that would sort each lane along a
+  //!                dimension
+  //! @param[in]     arr - the source array
+  //! @param[in]     dim - the dimension to sort along
+  //! @return        an array of the same size where each lane along 'dim'
+  //!                holds the positions of the elements in sorted order
+  //!
+  //! The sort is stable. Lanes are sorted in parallel when enabled. Integer
+  //! and floating point elements are sorted with a radix sort if the lanes are
+  //! long enough, which gives the same order as the comparison sort except for
+  //! lanes with NaNs, whose order is unspecified.
+  template <class T, std::size_t N>
+  NArray<pos_t, N> argsort(const NArray<T, N>& arr, std::size_t dim)
+  {
+    WILT_NARRAY_TRACE_SCOPE("argsort", arr);
+    using U = typename std::remove_const<T>::type;
+
+    if (dim >= N)
+      throw std::out_of_range("argsort(arr, dim): dim out of bounds");
+    if (arr.empty())
+      return NArray<pos_t, N>();
+
+    NArray<pos_t, N> ret(arr.sizes());
+    std::less<U> comp;
+    detail::argsortLanes(arr, ret, dim, comp, std::integral_constant<bool, detail::radix_traits<U>::enabled>());
+    return ret;
+  }
+
+  //! @brief         gets the indexes that would sort each lane along a
+  //!                dimension
+  //! @param[in]     arr - the source array
+  //! @param[in]     dim - the dimension to sort along
+  //! @param[in]     comp - function or function object with the signature
+  //!                bool(T, T) or similar, that returns if the first argument
+  //!                should be ordered before the second
+  //! @return        an array of the same size where each lane along 'dim'
+  //!                holds the positions of the elements in sorted order
+  //!
+  //! The sort is stable. Lanes are sorted in parallel when enabled.
+  template <class T, std::size_t N, class Compare>
+  NArray<pos_t, N> argsort(const NArray<T, N>& arr, std::size_t dim, Compare comp)
+  {
+    WILT_NARRAY_TRACE_SCOPE("argsort", arr);
+    if (dim >= N)
+      throw std::out_of_range("argsort(arr, dim, comp): dim out of bounds");
+    if (arr.empty())
+      return NArray<pos_t, N>();
+
+    NArray<pos_t, N> ret(arr.sizes());
+    detail::argsortLanes(arr, ret, dim, comp, std::false_type());
+    return ret;
+  }
+
+  //! @brief         gets the element that would be at a position along a
+  //!                dimension if each lane were sorted
+  //! @param[in]     arr - the source array
+  //! @param[in]     dim - the dimension to select along
+  //! @param[in]     k - the position in each sorted lane
+  //! @return        an array of the same size except with a size of 1 along
+  //!                'dim', holding the selected element of each lane
+  //!
+  //! The source array is not modified, lanes are copied into scratch buffers
+  //! that are reused by each thread. Lanes are handled in parallel when
+  //! enabled. Positions near either end of a lane are selected with a heap
+  //! instead of copying the lane.
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> nthElement(const NArray<T, N>& arr, std::size_t dim, pos_t k)
+  {
+    WILT_NARRAY_TRACE_SCOPE("nthElement", arr);
+    using U = typename std::remove_const<T>::type;
+
+    if (dim >= N)
+      throw std::out_of_range("nthElement(arr, dim, k): dim out of bounds");
+    if (arr.empty())
+      return NArray<U, N>();
+    if (k < 0 || k >= arr.sizes()[dim])
+      throw std::out_of_range("nthElement(arr, dim, k): k out of bounds");
+
+    Point<N> sizes = arr.sizes();
+    sizes[dim] = 1;
+
+    NArray<U, N> ret(sizes);
+    detail::selectLanes(arr, ret, dim, k);
+    return ret;
+  }
+
+  //! @brief         gets the largest elements along a dimension and their
+  //!                positions
+  //! @param[in]     arr - the source array
+  //! @param[in]     dim - the dimension to select along
+  //! @param[in]     k - the number of elements to get from each lane
+  //! @return        a pair of arrays of the same size except with a size of 'k'
+  //!                along 'dim', the first holding the largest elements of
+  //!                each lane in descending order and the second holding their
+  //!                positions in the lane
+  //!
+  //! Equal elements are ordered by their position. Lanes are handled in
+  //! parallel when enabled. Small values of 'k' are selected with a heap
+  //! instead of copying the lane.
+  template <class T, std::size_t N>
+  std::pair<NArray<typename std::remove_const<T>::type, N>, NArray<pos_t, N>> topK(const NArray<T, N>& arr, std::size_t dim, pos_t k)
+  {
+    WILT_NARRAY_TRACE_SCOPE("topK", arr);
+    using U = typename std::remove_const<T>::type;
+
+    if (dim >= N)
+      throw std::out_of_range("topK(arr, dim, k): dim out of bounds");
+    if (arr.empty())
+      return std::make_pair(NArray<U, N>(), NArray<pos_t, N>());
+    if (k < 1 || k > arr.sizes()[dim])
+      throw std::out_of_range("topK(arr, dim, k): k out of bounds");
+
+    Point<N> sizes = arr.sizes();
+    sizes[dim] = k;
+
+    NArray<U, N> values(sizes);
+    NArray<pos_t, N> indices(sizes);
+    detail::topKLanes(arr, values, indices, dim, k);
+    return std::make_pair(values, indices);
+  }
+
+  //! @brief         gets the median of each lane along a dimension
+  //! @param[in]     arr - the source array
+  //! @param[in]     dim - the dimension to select along
+  //! @return        an array of the same size except with a size of 1 along
+  //!                'dim', holding the median of each lane
+  //!
+  //! Lanes with an even number of elements use the lower of the two middle
+  //! elements, so no arithmetic is needed on 'T'. Equivalent to
+  //! nthElement(arr, dim, (arr.sizes()[dim] - 1) / 2).
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> median(const NArray<T, N>& arr, std::size_t dim)
+  {
+    WILT_NARRAY_TRACE_SCOPE("median", arr);
+    if (dim >= N)
+      throw std::out_of_range("median(arr, dim): dim out of bounds");
+    if (arr.empty())
+      return NArray<typename std::remove_const<T>::type, N>();
+
+    return nthElement(arr, dim, (arr.sizes()[dim] - 1) / 2);
+  }
+
+  //! @brief         counts the elements of an array in equal width bins
+  //! @param[in]     arr - the source array
+  //! @param[in]     bins - the number of bins
+  //! @param[in]     lo - the lower edge of the first bin
+  //! @param[in]     hi - the upper edge of the last bin
+  //! @return        an array of 'bins' counts
+  //!
+  //! Each bin includes its lower edge, the last bin also includes 'hi'.
+  //! Elements outside [lo, hi] and NaNs are not counted. Elements are counted
+  //! in parallel when enabled, each thread counting into its own bins which
+  //! are summed at the end.
+  template <class T, std::size_t N>
+  NArray<std::size_t, 1> histogram(const NArray<T, N>& arr, pos_t bins, double lo, double hi)
+  {
+    WILT_NARRAY_TRACE_SCOPE("histogram", arr);
+    if (bins < 1)
+      throw std::invalid_argument("histogram(arr, bins, lo, hi): bins must be positive");
+    if (!(lo < hi))
+      throw std::invalid_argument("histogram(arr, bins, lo, hi): lo must be less than hi");
+
+    std::vector<std::vector<std::size_t>> counts(1, std::vector<std::size_t>(bins + 1));
+    if (!arr.empty())
+    {
+      Point<N> sizes = arr.sizes();
+      Point<N> steps = arr.steps();
+      detail::condense(sizes, steps);
+
+      const pos_t count = (pos_t)arr.size();
+      const std::size_t chunks = detail::chunkCount(count, detail::PARALLEL_GRAIN);
+      counts.resize(chunks, std::vector<std::size_t>(bins + 1));
+      detail::parallelChunks(count, chunks, [&](std::size_t c, pos_t begin, pos_t end) {
+        std::size_t* local = counts[c].data();
+        auto func = [&](const T* data, pos_t step, pos_t n) { detail::binRun(data, step, n, local, bins, lo, hi); };
+        detail::forRuns(arr.data(), sizes, steps, begin, end, func);
+      });
+    }
+
+    NArray<std::size_t, 1> ret(Point<1>{ bins });
+    for (pos_t i = 0; i < bins; ++i)
+    {
+      std::size_t total = 0;
+      for (const auto& local : counts)
+        total += local[i];
+      ret.data()[i] = total;
+    }
+    return ret;
+  }
+
+  //! @brief         counts the elements of each lane along a dimension in equal
+  //!                width bins
+  //! @param[in]     arr - the source array
+  //! @param[in]     dim - the dimension of the lanes
+  //! @param[in]     bins - the number of bins
+  //! @param[in]     lo - the lower edge of the first bin
+  //! @param[in]     hi - the upper edge of the last bin
+  //! @return        an array of the same size except with a size of 'bins'
+  //!                along 'dim', holding the counts of each lane
+  //!
+  //! Each bin includes its lower edge, the last bin also includes 'hi'.
+  //! Elements outside [lo, hi] and NaNs are not counted. Lanes are counted in
+  //! parallel when enabled.
+  template <class T, std::size_t N>
+  NArray<std::size_t, N> histogram(const NArray<T, N>& arr, std::size_t dim, pos_t bins, double lo, double hi)
+  {
+    WILT_NARRAY_TRACE_SCOPE("histogram", arr);
+    if (dim >= N)
+      throw std::out_of_range("histogram(arr, dim, bins, lo, hi): dim out of bounds");
+    if (bins < 1)
+      throw std::invalid_argument("histogram(arr, dim, bins, lo, hi): bins must be positive");
+    if (!(lo < hi))
+      throw std::invalid_argument("histogram(arr, dim, bins, lo, hi): lo must be less than hi");
+    if (arr.empty())
+      return NArray<std::size_t, N>();
+
+    Point<N> retsizes = arr.sizes();
+    retsizes[dim] = bins;
+    NArray<std::size_t, N> ret(retsizes);
+
+    const pos_t length = arr.sizes()[dim];
+    const pos_t lanes = (pos_t)arr.size() / length;
+    const pos_t step = arr.steps()[dim];
+    const pos_t retstep = ret.steps()[dim];
+    const auto sizes = arr.sizes().removed(dim);
+    const auto steps = arr.steps().removed(dim);
+    const auto retsteps = ret.steps().removed(dim);
+
+    detail::parallelFor(lanes, std::max<pos_t>(1, detail::PARALLEL_GRAIN / length), [&](pos_t begin, pos_t end) {
+      std::vector<std::size_t> counts(bins + 1);
+      for (pos_t l = begin; l < end; ++l)
+      {
+        std::fill(counts.begin(), counts.end(), std::size_t(0));
+        detail::binRun(arr.data() + detail::offsetOf(l, sizes, steps), step, length, counts.data(), bins, lo, hi);
+
+        std::size_t* retlane = ret.data() + detail::offsetOf(l, sizes, retsteps);
+        for (pos_t i = 0; i < bins; ++i)
+          retlane[i * retstep] = counts[i];
+      }
+    });
+
+    return ret;
+  }
+
+  //! @brief         counts the occurrences of each value in an array
+  //! @param[in]     arr - the source array of non-negative integers
+  //! @return        an array of counts, one more than the largest value in
+  //!                'arr' long, where the count of 'v' is at position 'v'
+  //!
+  //! Elements are counted in parallel when enabled, each thread counting into
+  //! its own bins which are summed at the end.
+  template <class T, std::size_t N>
+  NArray<std::size_t, 1> bincount(const NArray<T, N>& arr)
+  {
+    WILT_NARRAY_TRACE_SCOPE("bincount", arr);
+    static_assert(std::is_integral<T>::value, "bincount(arr): invalid when element type is not integral");
+
+    using U = typename std::remove_const<T>::type;
+
+    if (arr.empty())
+      return NArray<std::size_t, 1>();
+
+    Point<N> sizes = arr.sizes();
+    Point<N> steps = arr.steps();
+    detail::condense(sizes, steps);
+
+    const pos_t count = (pos_t)arr.size();
+    const std::size_t chunks = detail::chunkCount(count, detail::PARALLEL_GRAIN);
+
+    std::vector<std::pair<U, U>> ranges(chunks, std::make_pair(arr.data()[0], arr.data()[0]));
+    detail::parallelChunks(count, chunks, [&](std::size_t c, pos_t begin, pos_t end) {
+      U lo = ranges[c].first;
+      U hi = ranges[c].second;
+      auto func = [&](const T* data, pos_t step, pos_t n) {
+        for (pos_t i = 0; i < n; ++i)
+        {
+          lo = std::min<U>(lo, data[i * step]);
+          hi = std::max<U>(hi, data[i * step]);
+        }
+      };
+      detail::forRuns(arr.data(), sizes, steps, begin, end, func);
+      ranges[c] = std::make_pair(lo, hi);
+    });
+
+    U lo = ranges[0].first;
+    U hi = ranges[0].second;
+    for (const auto& range : ranges)
+    {
+      lo = std::min(lo, range.first);
+      hi = std::max(hi, range.second);
+    }
+    if (lo < 0)
+      throw std::domain_error("bincount(arr): values must be non-negative");
+    if ((std::uintmax_t)hi >= (std::uintmax_t)std::numeric_limits<pos_t>::max())
+      throw std::invalid_argument("bincount(arr): values must be less than the largest pos_t");
+
+    const pos_t bins = (pos_t)hi + 1;
+    std::vector<std::vector<std::size_t>> counts(chunks, std::vector<std::size_t>(bins));
+    detail::parallelChunks(count, chunks, [&](std::size_t c, pos_t begin, pos_t end) {
+      std::size_t* local = counts[c].data();
+      auto func = [&](const T* data, pos_t step, pos_t n) {
+        for (pos_t i = 0; i < n; ++i)
+          ++local[(std::size_t)data[i * step]];
+      };
+      detail::forRuns(arr.data(), sizes, steps, begin, end, func);
+    });
+
+    NArray<std::size_t, 1> ret(Point<1>{ bins });
+    for (pos_t i = 0; i < bins; ++i)
+    {
+      std::size_t total = 0;
+      for (const auto& local : counts)
+        total += local[i];
+      ret.data()[i] = total;
+    }
+    return ret;
+  }
+
+} // namespace wilt
+
+#endif // !WILT_ALGORITHMS_HPP
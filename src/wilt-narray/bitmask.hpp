@@ -0,0 +1,474 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: bitmask.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines the BitMask class that stores a boolean mask one bit per element
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_BITMASK_HPP
+#define WILT_BITMASK_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "checks.hpp"
+#include "narray.hpp"
+#include "parallel.hpp"
+
+namespace wilt
+{
+namespace detail
+{
+  // Gets the number of set bits in 'word'.
+  inline pos_t popcount(std::uint64_t word) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return pos_t((word * 0x0101010101010101ull) >> 56);
+#endif
+  }
+
+  // Gets the position of the lowest set bit in 'word', which must not be 0.
+  inline pos_t countTrailingZeros(std::uint64_t word) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    pos_t n = 0;
+    for (; (word & 1) == 0; word >>= 1)
+      ++n;
+    return n;
+#endif
+  }
+
+} // namespace detail
+
+  //////////////////////////////////////////////////////////////////////////////
+  // This class is designed to hold an N-dimensional boolean mask, like those
+  // from `compareEQ()` and the other compare functions, in an eighth of the
+  // memory of an `NArray<bool, N>`.
+  //
+  // This class works by packing the elements, in order, into 64-bit words.
+  // Element 'n' is bit 'n % 64' of word 'n / 64' and the unused bits of the
+  // last word are always clear. This lets the logical operators and count()
+  // work on whole words at a time.
+  //
+  // Unlike NArray, a BitMask owns its bits and copies are independent. It does
+  // not support views like slicing or transposing, masks should be made from
+  // an NArray that already has the desired view.
+
+  template <std::size_t N>
+  class BitMask
+  {
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // TYPE DEFINITIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    using word_type = std::uint64_t;
+
+    static constexpr pos_t word_bits = 64;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    // PRIVATE MEMBERS
+    ////////////////////////////////////////////////////////////////////////////
+
+    std::vector<word_type> words_; // packed bits, in element order
+    Point<N> sizes_;               // dimension sizes of the mask
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // CONSTRUCTORS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Default constructor, makes an empty mask
+    BitMask() noexcept;
+
+    // Creates a mask of the given size with every element set to 'val'
+    BitMask(const Point<N>& size, bool val = false);
+
+    // Creates a mask from a boolean array
+    template <class B>
+    explicit BitMask(const NArray<B, N>& mask);
+
+    // Creates a mask from the results of 'pred(elem)' for each element of the
+    // array, without building an NArray<bool, N> first
+    template <class T, class Predicate>
+    BitMask(const NArray<T, N>& arr, Predicate pred);
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // QUERY FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Functions for getting the dimensions of the mask
+    const Point<N>& sizes() const noexcept;
+    std::size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    // Gets the number of set elements
+    pos_t count() const noexcept;
+
+    // Gets the packed words, there are 'wordCount()' of them
+    const word_type* words() const noexcept;
+    std::size_t wordCount() const noexcept;
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // ACCESS FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Functions for getting and setting the element at the location, will throw
+    // if out of bounds
+    bool at(const Point<N>& loc) const;
+    void set(const Point<N>& loc, bool val);
+
+    // Gets the nth element in order, no bounds checking
+    bool test(pos_t n) const noexcept;
+
+    // Calls 'func(n)' in order for each set element 'n' from 'begin' to 'end'.
+    // Clear words are skipped without checking each bit.
+    template <class Function>
+    void forEachSet(pos_t begin, pos_t end, Function func) const;
+
+    // Unpacks the mask into an array
+    NArray<bool, N> toNArray() const;
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // OPERATORS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Element-wise logical operations, the masks must be the same size
+    BitMask<N>& operator&= (const BitMask<N>& mask);
+    BitMask<N>& operator|= (const BitMask<N>& mask);
+    BitMask<N>& operator^= (const BitMask<N>& mask);
+    BitMask<N> operator~ () const;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    // PRIVATE FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    template <class T, class Predicate>
+    void pack_(const NArray<T, N>& arr, Predicate& pred);
+
+    template <class Operator>
+    void combine_(const BitMask<N>& mask, Operator op);
+
+    pos_t index_(const Point<N>& loc) const noexcept;
+    void trim_() noexcept;
+
+  }; // class BitMask
+
+  template <std::size_t N>
+  BitMask<N> operator& (const BitMask<N>& lhs, const BitMask<N>& rhs);
+  template <std::size_t N>
+  BitMask<N> operator| (const BitMask<N>& lhs, const BitMask<N>& rhs);
+  template <std::size_t N>
+  BitMask<N> operator^ (const BitMask<N>& lhs, const BitMask<N>& rhs);
+
+  template <std::size_t N>
+  BitMask<N>::BitMask() noexcept
+    : words_()
+    , sizes_()
+  {
+
+  }
+
+  template <std::size_t N>
+  BitMask<N>::BitMask(const Point<N>& size, bool val)
+    : words_()
+    , sizes_()
+  {
+    WILT_NARRAY_CHECK(wilt::detail::validSize(size), std::invalid_argument, "BitMask(size, val): size is not valid");
+
+    sizes_ = size;
+    words_.assign((wilt::detail::size(size) + word_bits - 1) / word_bits, val ? ~word_type(0) : word_type(0));
+    trim_();
+  }
+
+  template <std::size_t N>
+  template <class B>
+  BitMask<N>::BitMask(const NArray<B, N>& mask)
+    : words_()
+    , sizes_()
+  {
+    auto pred = [](bool m) { return m; };
+    pack_(mask, pred);
+  }
+
+  template <std::size_t N>
+  template <class T, class Predicate>
+  BitMask<N>::BitMask(const NArray<T, N>& arr, Predicate pred)
+    : words_()
+    , sizes_()
+  {
+    pack_(arr, pred);
+  }
+
+  template <std::size_t N>
+  const Point<N>& BitMask<N>::sizes() const noexcept
+  {
+    return sizes_;
+  }
+
+  template <std::size_t N>
+  std::size_t BitMask<N>::size() const noexcept
+  {
+    return words_.empty() ? 0 : (std::size_t)wilt::detail::size(sizes_);
+  }
+
+  template <std::size_t N>
+  bool BitMask<N>::empty() const noexcept
+  {
+    return words_.empty();
+  }
+
+  template <std::size_t N>
+  pos_t BitMask<N>::count() const noexcept
+  {
+    pos_t total = 0;
+    for (word_type word : words_)
+      total += wilt::detail::popcount(word);
+    return total;
+  }
+
+  template <std::size_t N>
+  const typename BitMask<N>::word_type* BitMask<N>::words() const noexcept
+  {
+    return words_.data();
+  }
+
+  template <std::size_t N>
+  std::size_t BitMask<N>::wordCount() const noexcept
+  {
+    return words_.size();
+  }
+
+  template <std::size_t N>
+  bool BitMask<N>::at(const Point<N>& loc) const
+  {
+    WILT_NARRAY_CHECK(!empty(), std::runtime_error, "at(loc): invalid when empty");
+
+    for (std::size_t i = 0; i < N; ++i)
+      WILT_NARRAY_CHECK(loc[i] < sizes_[i] && loc[i] >= 0, std::out_of_range, "at(loc): element larger then dimensions");
+
+    return test(index_(loc));
+  }
+
+  template <std::size_t N>
+  void BitMask<N>::set(const Point<N>& loc, bool val)
+  {
+    WILT_NARRAY_CHECK(!empty(), std::runtime_error, "set(loc, val): invalid when empty");
+
+    for (std::size_t i = 0; i < N; ++i)
+      WILT_NARRAY_CHECK(loc[i] < sizes_[i] && loc[i] >= 0, std::out_of_range, "set(loc, val): element larger then dimensions");
+
+    const pos_t n = index_(loc);
+    const word_type bit = word_type(1) << (n % word_bits);
+    if (val)
+      words_[n / word_bits] |= bit;
+    else
+      words_[n / word_bits] &= ~bit;
+  }
+
+  template <std::size_t N>
+  bool BitMask<N>::test(pos_t n) const noexcept
+  {
+    return (words_[n / word_bits] >> (n % word_bits)) & 1;
+  }
+
+  template <std::size_t N>
+  template <class Function>
+  void BitMask<N>::forEachSet(pos_t begin, pos_t end, Function func) const
+  {
+    while (begin < end)
+    {
+      word_type word = words_[begin / word_bits] >> (begin % word_bits);
+      const pos_t next = std::min(end, (begin / word_bits + 1) * word_bits);
+      while (word != 0)
+      {
+        const pos_t n = begin + wilt::detail::countTrailingZeros(word);
+        if (n >= next)
+          break;
+        func(n);
+        word &= word - 1;
+      }
+      begin = next;
+    }
+  }
+
+  template <std::size_t N>
+  NArray<bool, N> BitMask<N>::toNArray() const
+  {
+    if (empty())
+      return NArray<bool, N>();
+
+    NArray<bool, N> ret(sizes_, false);
+    bool* data = ret.data();
+    forEachSet(0, (pos_t)size(), [data](pos_t n) { data[n] = true; });
+    return ret;
+  }
+
+  template <std::size_t N>
+  BitMask<N>& BitMask<N>::operator&= (const BitMask<N>& mask)
+  {
+    WILT_NARRAY_CHECK(sizes_ == mask.sizes_, std::invalid_argument, "operator&=(mask): dimensions must match");
+
+    combine_(mask, [](word_type a, word_type b) { return a & b; });
+    return *this;
+  }
+
+  template <std::size_t N>
+  BitMask<N>& BitMask<N>::operator|= (const BitMask<N>& mask)
+  {
+    WILT_NARRAY_CHECK(sizes_ == mask.sizes_, std::invalid_argument, "operator|=(mask): dimensions must match");
+
+    combine_(mask, [](word_type a, word_type b) { return a | b; });
+    return *this;
+  }
+
+  template <std::size_t N>
+  BitMask<N>& BitMask<N>::operator^= (const BitMask<N>& mask)
+  {
+    WILT_NARRAY_CHECK(sizes_ == mask.sizes_, std::invalid_argument, "operator^=(mask): dimensions must match");
+
+    combine_(mask, [](word_type a, word_type b) { return a ^ b; });
+    return *this;
+  }
+
+  template <std::size_t N>
+  BitMask<N> BitMask<N>::operator~ () const
+  {
+    BitMask<N> ret = *this;
+    word_type* words = ret.words_.data();
+    wilt::detail::parallelFor((pos_t)words_.size(), wilt::detail::PARALLEL_GRAIN, [words](pos_t begin, pos_t end) {
+      for (pos_t i = begin; i < end; ++i)
+        words[i] = ~words[i];
+    });
+    ret.trim_();
+    return ret;
+  }
+
+  template <std::size_t N>
+  template <class T, class Predicate>
+  void BitMask<N>::pack_(const NArray<T, N>& arr, Predicate& pred)
+  {
+    if (arr.empty())
+      return;
+
+    Point<N> sizes = arr.sizes();
+    Point<N> steps = arr.steps();
+    wilt::detail::condense(sizes, steps);
+
+    const pos_t count = (pos_t)arr.size();
+    const pos_t length = sizes[N-1];
+    const pos_t step = steps[N-1];
+    const auto outersizes = sizes.removed(N-1);
+    const auto outersteps = steps.removed(N-1);
+
+    sizes_ = arr.sizes();
+    words_.assign((count + word_bits - 1) / word_bits, word_type(0));
+
+    // each segment covers whole words so no word is written by two threads
+    word_type* words = words_.data();
+    wilt::detail::parallelFor((pos_t)words_.size(), wilt::detail::PARALLEL_GRAIN / word_bits, [&](pos_t begin, pos_t end) {
+      pos_t n = begin * word_bits;
+      const pos_t last = std::min(count, end * word_bits);
+      while (n < last)
+      {
+        const pos_t col = n % length;
+        const pos_t run = std::min(length - col, last - n);
+        const T* data = arr.data() + wilt::detail::offsetOf(n / length, outersizes, outersteps) + col * step;
+        for (pos_t i = 0; i < run; ++i, ++n)
+          if (pred(data[i * step]))
+            words[n / word_bits] |= word_type(1) << (n % word_bits);
+      }
+    });
+  }
+
+  template <std::size_t N>
+  template <class Operator>
+  void BitMask<N>::combine_(const BitMask<N>& mask, Operator op)
+  {
+    word_type* words = words_.data();
+    const word_type* other = mask.words_.data();
+    wilt::detail::parallelFor((pos_t)words_.size(), wilt::detail::PARALLEL_GRAIN, [&](pos_t begin, pos_t end) {
+      for (pos_t i = begin; i < end; ++i)
+        words[i] = op(words[i], other[i]);
+    });
+  }
+
+  template <std::size_t N>
+  pos_t BitMask<N>::index_(const Point<N>& loc) const noexcept
+  {
+    pos_t n = 0;
+    for (std::size_t i = 0; i < N; ++i)
+      n = n * sizes_[i] + loc[i];
+    return n;
+  }
+
+  template <std::size_t N>
+  void BitMask<N>::trim_() noexcept
+  {
+    const pos_t used = (pos_t)size() % word_bits;
+    if (used != 0)
+      words_.back() &= (word_type(1) << used) - 1;
+  }
+
+  template <std::size_t N>
+  BitMask<N> operator& (const BitMask<N>& lhs, const BitMask<N>& rhs)
+  {
+    BitMask<N> ret = lhs;
+    ret &= rhs;
+    return ret;
+  }
+
+  template <std::size_t N>
+  BitMask<N> operator| (const BitMask<N>& lhs, const BitMask<N>& rhs)
+  {
+    BitMask<N> ret = lhs;
+    ret |= rhs;
+    return ret;
+  }
+
+  template <std::size_t N>
+  BitMask<N> operator^ (const BitMask<N>& lhs, const BitMask<N>& rhs)
+  {
+    BitMask<N> ret = lhs;
+    ret ^= rhs;
+    return ret;
+  }
+
+} // namespace wilt
+
+#endif // !WILT_BITMASK_HPP
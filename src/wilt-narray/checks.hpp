@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: checks.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines the WILT_NARRAY_CHECKS policy for validating arguments
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_CHECKS_HPP
+#define WILT_CHECKS_HPP
+
+#include <cassert>
+#include <stdexcept>
+
+// The policy for handling invalid arguments, like out-of-bounds indexes or
+// mismatched dimensions, is picked by defining `WILT_NARRAY_CHECKS` as one of:
+//   - throw  = check and throw an exception (the default)
+//   - assert = check with assert(), so only when NDEBUG isn't defined
+//   - none   = don't check, invalid arguments are undefined behavior
+//
+// The policy must be the same in every translation unit of a program.
+#define WILT_NARRAY_CHECKS_throw 1
+#define WILT_NARRAY_CHECKS_assert 2
+#define WILT_NARRAY_CHECKS_none 3
+
+#if !defined(WILT_NARRAY_CHECKS)
+#define WILT_NARRAY_CHECKS throw
+#endif
+
+#define WILT_NARRAY_CHECKS_POLICY_(policy) WILT_NARRAY_CHECKS_ ## policy
+#define WILT_NARRAY_CHECKS_POLICY(policy) WILT_NARRAY_CHECKS_POLICY_(policy)
+
+// Checks that 'cond' holds for the arguments according to the policy. Under
+// 'throw' it throws 'exception(message)' if it doesn't, under 'assert' it
+// asserts with the message and under 'none' it doesn't evaluate 'cond'.
+#if WILT_NARRAY_CHECKS_POLICY(WILT_NARRAY_CHECKS) == WILT_NARRAY_CHECKS_throw
+#define WILT_NARRAY_CHECK(cond, exception, message) do { if (!(cond)) throw exception(message); } while (false)
+#elif WILT_NARRAY_CHECKS_POLICY(WILT_NARRAY_CHECKS) == WILT_NARRAY_CHECKS_assert
+#define WILT_NARRAY_CHECK(cond, exception, message) assert((cond) && message)
+#elif WILT_NARRAY_CHECKS_POLICY(WILT_NARRAY_CHECKS) == WILT_NARRAY_CHECKS_none
+#define WILT_NARRAY_CHECK(cond, exception, message) ((void)sizeof(!(cond)))
+#else
+#error "WILT_NARRAY_CHECKS must be one of throw, assert or none"
+#endif
+
+#endif // !WILT_CHECKS_HPP
@@ -0,0 +1,305 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: cow.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines the CowNArray class, a copy-on-write variant of NArray
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_COW_HPP
+#define WILT_COW_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "checks.hpp"
+#include "narray.hpp"
+
+namespace wilt
+{
+  //////////////////////////////////////////////////////////////////////////////
+  // This class is designed to give value semantics to N-dimensional data
+  // without paying for a copy until one is needed. Copies of a CowNArray, and
+  // CowNArrays made from an existing NArray, share data like a view would.
+  //
+  // Every mutating function first checks if the data is shared with anything
+  // else, a CowNArray or a plain NArray, and if so clones the reachable region
+  // into its own data before writing. Writes to unshared data are done in place
+  // with no extra cost beyond that check.
+  //
+  // Note that the non-const 'at()' counts as a write, like with other copy-on-
+  // write containers, so use 'view()' or a const reference for read-only access
+  // to avoid an unneeded copy. References and views from 'at()' or 'edit()' are
+  // only valid until the CowNArray is copied.
+
+  template <class T, std::size_t N>
+  class CowNArray
+  {
+    static_assert(!std::is_const<T>::value, "CowNArray<T, N>: T must not be const");
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // TYPE DEFINITIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    // PRIVATE MEMBERS
+    ////////////////////////////////////////////////////////////////////////////
+
+    NArray<T, N> arr_; // the possibly shared data
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // CONSTRUCTORS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Default constructor, makes an empty array
+    CowNArray() noexcept;
+
+    // Shares the data of the array, it is not copied until written to
+    explicit CowNArray(const NArray<T, N>& arr) noexcept;
+
+    // Creates an array of the given size with default or 'val' elements
+    explicit CowNArray(const Point<N>& size);
+    CowNArray(const Point<N>& size, const T& val);
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // QUERY FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Functions for getting the dimensions of the array
+    const Point<N>& sizes() const noexcept;
+    std::size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    // Returns true if a write would copy the data first
+    bool shared() const noexcept;
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // ACCESS FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Gets a read-only view of the data, never copies
+    NArray<const T, N> view() const noexcept;
+
+    // Gets the element at the location, will throw if out of bounds. The
+    // non-const versions copy the data if shared.
+    const_reference at(const Point<N>& loc) const;
+    reference at(const Point<N>& loc);
+
+    // Gets a writable view of the data, copying it first if shared
+    NArray<T, N> edit();
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // MODIFIERS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Element-wise assignment and arithmetic, each copies the data first if
+    // shared. Arrays must be the same size.
+    void setTo(const NArray<const T, N>& arr);
+    void setTo(const T& val);
+
+    CowNArray<T, N>& operator+= (const NArray<const T, N>& arr);
+    CowNArray<T, N>& operator+= (const T& val);
+    CowNArray<T, N>& operator-= (const NArray<const T, N>& arr);
+    CowNArray<T, N>& operator-= (const T& val);
+    CowNArray<T, N>& operator*= (const T& val);
+    CowNArray<T, N>& operator/= (const T& val);
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    // PRIVATE FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    void detach_();
+
+  }; // class CowNArray
+
+  template <class T, std::size_t N>
+  CowNArray<T, N>::CowNArray() noexcept
+    : arr_()
+  {
+
+  }
+
+  template <class T, std::size_t N>
+  CowNArray<T, N>::CowNArray(const NArray<T, N>& arr) noexcept
+    : arr_(arr)
+  {
+
+  }
+
+  template <class T, std::size_t N>
+  CowNArray<T, N>::CowNArray(const Point<N>& size)
+    : arr_(size)
+  {
+
+  }
+
+  template <class T, std::size_t N>
+  CowNArray<T, N>::CowNArray(const Point<N>& size, const T& val)
+    : arr_(size, val)
+  {
+
+  }
+
+  template <class T, std::size_t N>
+  const Point<N>& CowNArray<T, N>::sizes() const noexcept
+  {
+    return arr_.sizes();
+  }
+
+  template <class T, std::size_t N>
+  std::size_t CowNArray<T, N>::size() const noexcept
+  {
+    return arr_.size();
+  }
+
+  template <class T, std::size_t N>
+  bool CowNArray<T, N>::empty() const noexcept
+  {
+    return arr_.empty();
+  }
+
+  template <class T, std::size_t N>
+  bool CowNArray<T, N>::shared() const noexcept
+  {
+    return arr_.shared();
+  }
+
+  template <class T, std::size_t N>
+  NArray<const T, N> CowNArray<T, N>::view() const noexcept
+  {
+    return arr_;
+  }
+
+  template <class T, std::size_t N>
+  typename CowNArray<T, N>::const_reference CowNArray<T, N>::at(const Point<N>& loc) const
+  {
+    return arr_.at(loc);
+  }
+
+  template <class T, std::size_t N>
+  typename CowNArray<T, N>::reference CowNArray<T, N>::at(const Point<N>& loc)
+  {
+    arr_.at(loc); // check bounds before copying anything
+
+    detach_();
+    return arr_.at(loc);
+  }
+
+  template <class T, std::size_t N>
+  NArray<T, N> CowNArray<T, N>::edit()
+  {
+    detach_();
+    return arr_;
+  }
+
+  template <class T, std::size_t N>
+  void CowNArray<T, N>::setTo(const NArray<const T, N>& arr)
+  {
+    WILT_NARRAY_CHECK(arr_.sizes() == arr.sizes(), std::invalid_argument, "setTo(arr): dimensions must match");
+
+    detach_();
+    arr_.setTo(arr);
+  }
+
+  template <class T, std::size_t N>
+  void CowNArray<T, N>::setTo(const T& val)
+  {
+    detach_();
+    arr_.setTo(val);
+  }
+
+  template <class T, std::size_t N>
+  CowNArray<T, N>& CowNArray<T, N>::operator+= (const NArray<const T, N>& arr)
+  {
+    WILT_NARRAY_CHECK(arr_.sizes() == arr.sizes(), std::invalid_argument, "operator+=(arr): dimensions must match");
+
+    detach_();
+    arr_ += arr;
+    return *this;
+  }
+
+  template <class T, std::size_t N>
+  CowNArray<T, N>& CowNArray<T, N>::operator+= (const T& val)
+  {
+    detach_();
+    arr_ += val;
+    return *this;
+  }
+
+  template <class T, std::size_t N>
+  CowNArray<T, N>& CowNArray<T, N>::operator-= (const NArray<const T, N>& arr)
+  {
+    WILT_NARRAY_CHECK(arr_.sizes() == arr.sizes(), std::invalid_argument, "operator-=(arr): dimensions must match");
+
+    detach_();
+    arr_ -= arr;
+    return *this;
+  }
+
+  template <class T, std::size_t N>
+  CowNArray<T, N>& CowNArray<T, N>::operator-= (const T& val)
+  {
+    detach_();
+    arr_ -= val;
+    return *this;
+  }
+
+  template <class T, std::size_t N>
+  CowNArray<T, N>& CowNArray<T, N>::operator*= (const T& val)
+  {
+    detach_();
+    arr_ *= val;
+    return *this;
+  }
+
+  template <class T, std::size_t N>
+  CowNArray<T, N>& CowNArray<T, N>::operator/= (const T& val)
+  {
+    detach_();
+    arr_ /= val;
+    return *this;
+  }
+
+  template <class T, std::size_t N>
+  void CowNArray<T, N>::detach_()
+  {
+    // cloning only copies the region this array can reach, so a CowNArray made
+    // from a small view of a large block ends up with right-sized data
+    if (arr_.shared())
+      arr_ = arr_.clone();
+  }
+
+} // namespace wilt
+
+#endif // !WILT_COW_HPP
@@ -0,0 +1,338 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: fft.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines fast Fourier transforms along a dimension of an NArray
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_FFT_HPP
+#define WILT_FFT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "narray.hpp"
+#include "parallel.hpp"
+
+namespace wilt
+{
+namespace detail
+{
+  // The `complex_traits` class determines if a type is a std::complex and what
+  // its scalar type is.
+  template <class T>
+  struct complex_traits
+  {
+    static constexpr bool is_complex = false;
+    using value_type = T;
+  };
+
+  template <class F>
+  struct complex_traits<std::complex<F>>
+  {
+    static constexpr bool is_complex = true;
+    using value_type = F;
+  };
+
+  // The `FftPlan` class holds what is needed to transform a specific length,
+  // which is the factorization of the length and the twiddle factors. Plans
+  // are immutable once created so they can be shared between threads.
+  //
+  // The length is factored into radix-4 first, then radix-2, then odd
+  // factors, each stored as the factor followed by the remaining length.
+  // Radix-2 and radix-4 stages have dedicated butterflies and all others use a
+  // generic one, so any length is supported though those with large prime
+  // factors are slower.
+  template <class F>
+  struct FftPlan
+  {
+    pos_t length;
+    std::vector<pos_t> factors;
+    std::vector<std::complex<F>> twiddles;
+
+    explicit FftPlan(pos_t n)
+      : length(n)
+      , factors()
+      , twiddles(n)
+    {
+      const double pi = 3.14159265358979323846;
+      for (pos_t k = 0; k < n; ++k)
+        twiddles[k] = std::complex<F>(std::polar(1.0, -2.0 * pi * double(k) / double(n)));
+
+      pos_t p = 4;
+      const pos_t limit = pos_t(std::floor(std::sqrt(double(n))));
+      do
+      {
+        while (n % p != 0)
+        {
+          p = (p == 4) ? 2 : (p == 2) ? 3 : p + 2;
+          if (p > limit)
+            p = n;
+        }
+        n /= p;
+        factors.push_back(p);
+        factors.push_back(n);
+      } while (n > 1);
+    }
+  };
+
+  // Gets the plan for a length, creating it the first time. Plans are cached
+  // for the life of the program since the same lengths tend to be transformed
+  // repeatedly. Since lanes are gathered into contiguous buffers before they
+  // are transformed, plans do not depend on the stride of the lanes.
+  template <class F>
+  std::shared_ptr<const FftPlan<F>> fftPlan(pos_t n)
+  {
+    static std::mutex mutex;
+    static std::map<pos_t, std::shared_ptr<const FftPlan<F>>> plans;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const FftPlan<F>>& plan = plans[n];
+    if (!plan)
+      plan = std::make_shared<const FftPlan<F>>(n);
+    return plan;
+  }
+
+  template <class F>
+  void fftButterfly2(std::complex<F>* out, pos_t fstride, pos_t m, const FftPlan<F>& plan)
+  {
+    const std::complex<F>* tw = plan.twiddles.data();
+    for (pos_t i = 0; i < m; ++i)
+    {
+      const std::complex<F> t = out[i + m] * tw[i * fstride];
+      out[i + m] = out[i] - t;
+      out[i] += t;
+    }
+  }
+
+  template <class F>
+  void fftButterfly4(std::complex<F>* out, pos_t fstride, pos_t m, const FftPlan<F>& plan)
+  {
+    const std::complex<F>* tw = plan.twiddles.data();
+    for (pos_t i = 0; i < m; ++i)
+    {
+      const std::complex<F> s0 = out[i + m] * tw[i * fstride];
+      const std::complex<F> s1 = out[i + 2 * m] * tw[i * fstride * 2];
+      const std::complex<F> s2 = out[i + 3 * m] * tw[i * fstride * 3];
+      const std::complex<F> s3 = s0 + s2;
+      const std::complex<F> s4 = s0 - s2;
+      const std::complex<F> s5 = out[i] - s1;
+
+      out[i] += s1;
+      out[i + 2 * m] = out[i] - s3;
+      out[i] += s3;
+      out[i + m] = std::complex<F>(s5.real() + s4.imag(), s5.imag() - s4.real());
+      out[i + 3 * m] = std::complex<F>(s5.real() - s4.imag(), s5.imag() + s4.real());
+    }
+  }
+
+  template <class F>
+  void fftButterflyGeneric(std::complex<F>* out, pos_t fstride, pos_t m, pos_t p, const FftPlan<F>& plan, std::complex<F>* scratch)
+  {
+    const std::complex<F>* tw = plan.twiddles.data();
+    const pos_t n = plan.length;
+    for (pos_t u = 0; u < m; ++u)
+    {
+      for (pos_t q = 0; q < p; ++q)
+        scratch[q] = out[u + q * m];
+
+      for (pos_t q1 = 0; q1 < p; ++q1)
+      {
+        const pos_t k = u + q1 * m;
+        pos_t twidx = 0;
+        std::complex<F> sum = scratch[0];
+        for (pos_t q = 1; q < p; ++q)
+        {
+          twidx += fstride * k;
+          twidx %= n;
+          sum += scratch[q] * tw[twidx];
+        }
+        out[k] = sum;
+      }
+    }
+  }
+
+  // Computes the forward transform of the elements 'in[i * fstride]' into the
+  // contiguous 'out' by recursively splitting by the plan's factors, starting
+  // at 'factors'. The scratch buffer must hold as many elements as the largest
+  // factor.
+  template <class F>
+  void fftRecurse(std::complex<F>* out, const std::complex<F>* in, pos_t fstride, const pos_t* factors, const FftPlan<F>& plan, std::complex<F>* scratch)
+  {
+    const pos_t p = factors[0];
+    const pos_t m = factors[1];
+
+    if (m == 1)
+    {
+      for (pos_t j = 0; j < p; ++j)
+        out[j] = in[j * fstride];
+    }
+    else
+    {
+      for (pos_t j = 0; j < p; ++j)
+        fftRecurse(out + j * m, in + j * fstride, fstride * p, factors + 2, plan, scratch);
+    }
+
+    switch (p)
+    {
+    case 2:
+      fftButterfly2(out, fstride, m, plan);
+      break;
+    case 4:
+      fftButterfly4(out, fstride, m, plan);
+      break;
+    default:
+      fftButterflyGeneric(out, fstride, m, p, plan, scratch);
+      break;
+    }
+  }
+
+  // Transforms each lane along 'dim' of 'src' into the same lane of 'dst',
+  // keeping the first 'dst.sizes()[dim]' results. Lanes are gathered into a
+  // contiguous buffer first so strided lanes, like those of a transposed
+  // array, are read only once. The inverse is computed as the conjugate of the
+  // forward transform of the conjugate, scaled by 1/n.
+  template <class T, class F, std::size_t N>
+  void fftLanes(const NArray<T, N>& src, const NArray<std::complex<F>, N>& dst, std::size_t dim, bool inverse)
+  {
+    const pos_t length = src.sizes()[dim];
+    const pos_t outlength = dst.sizes()[dim];
+    const pos_t lanes = (pos_t)src.size() / length;
+    const pos_t srcstep = src.steps()[dim];
+    const pos_t dststep = dst.steps()[dim];
+    const auto sizes = src.sizes().removed(dim);
+    const auto srcsteps = src.steps().removed(dim);
+    const auto dststeps = dst.steps().removed(dim);
+
+    const std::shared_ptr<const FftPlan<F>> plan = fftPlan<F>(length);
+    pos_t largest = 0;
+    for (std::size_t i = 0; i < plan->factors.size(); i += 2)
+      largest = std::max(largest, plan->factors[i]);
+
+    const pos_t work = length * (pos_t)plan->factors.size();
+    parallelFor(lanes, std::max<pos_t>(1, PARALLEL_GRAIN / work), [&](pos_t begin, pos_t end) {
+      std::vector<std::complex<F>> in(length);
+      std::vector<std::complex<F>> out(length);
+      std::vector<std::complex<F>> scratch(largest);
+      for (pos_t l = begin; l < end; ++l)
+      {
+        const T* s = src.data() + offsetOf(l, sizes, srcsteps);
+        for (pos_t i = 0; i < length; ++i)
+          in[i] = inverse ? std::conj(std::complex<F>(s[i * srcstep])) : std::complex<F>(s[i * srcstep]);
+
+        fftRecurse(out.data(), in.data(), 1, plan->factors.data(), *plan, scratch.data());
+
+        std::complex<F>* d = dst.data() + offsetOf(l, sizes, dststeps);
+        const F scale = F(1) / F(length);
+        for (pos_t i = 0; i < outlength; ++i)
+          d[i * dststep] = inverse ? std::conj(out[i]) * scale : out[i];
+      }
+    });
+  }
+
+} // namespace detail
+
+  //! @brief         computes the discrete Fourier transform along a dimension
+  //! @param[in]     arr - the source array of std::complex elements
+  //! @param[in]     dim - the dimension to transform along
+  //! @return        a new array of the transformed lanes
+  //!
+  //! Uses a mixed-radix fast Fourier transform with plans cached by length.
+  //! Lanes are transformed in parallel when enabled.
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> fft(const NArray<T, N>& arr, std::size_t dim)
+  {
+    using C = typename std::remove_const<T>::type;
+    static_assert(detail::complex_traits<C>::is_complex, "fft(arr, dim): element type must be std::complex");
+
+    if (dim >= N)
+      throw std::out_of_range("fft(arr, dim): dim out of bounds");
+    if (arr.empty())
+      return NArray<C, N>();
+
+    NArray<C, N> ret(arr.sizes());
+    detail::fftLanes(arr, ret, dim, false);
+    return ret;
+  }
+
+  //! @brief         computes the inverse discrete Fourier transform along a
+  //!                dimension
+  //! @param[in]     arr - the source array of std::complex elements
+  //! @param[in]     dim - the dimension to transform along
+  //! @return        a new array of the transformed lanes, scaled by 1/n so
+  //!                that 'ifft(fft(arr, dim), dim)' is 'arr'
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> ifft(const NArray<T, N>& arr, std::size_t dim)
+  {
+    using C = typename std::remove_const<T>::type;
+    static_assert(detail::complex_traits<C>::is_complex, "ifft(arr, dim): element type must be std::complex");
+
+    if (dim >= N)
+      throw std::out_of_range("ifft(arr, dim): dim out of bounds");
+    if (arr.empty())
+      return NArray<C, N>();
+
+    NArray<C, N> ret(arr.sizes());
+    detail::fftLanes(arr, ret, dim, true);
+    return ret;
+  }
+
+  //! @brief         computes the discrete Fourier transform of real elements
+  //!                along a dimension
+  //! @param[in]     arr - the source array of floating point elements
+  //! @param[in]     dim - the dimension to transform along
+  //! @return        a new array of the non-negative frequency terms, with
+  //!                'n / 2 + 1' elements along 'dim'
+  //!
+  //! The negative frequency terms are omitted since they are the conjugates of
+  //! the positive ones for real input.
+  template <class T, std::size_t N>
+  NArray<std::complex<typename std::remove_const<T>::type>, N> rfft(const NArray<T, N>& arr, std::size_t dim)
+  {
+    using F = typename std::remove_const<T>::type;
+    static_assert(std::is_floating_point<F>::value, "rfft(arr, dim): element type must be floating point");
+
+    if (dim >= N)
+      throw std::out_of_range("rfft(arr, dim): dim out of bounds");
+    if (arr.empty())
+      return NArray<std::complex<F>, N>();
+
+    Point<N> sizes = arr.sizes();
+    sizes[dim] = sizes[dim] / 2 + 1;
+
+    NArray<std::complex<F>, N> ret(sizes);
+    detail::fftLanes(arr, ret, dim, false);
+    return ret;
+  }
+
+} // namespace wilt
+
+#endif // !WILT_FFT_HPP
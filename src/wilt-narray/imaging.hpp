@@ -0,0 +1,710 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: imaging.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines image-processing structures and functions for NArrays
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_IMAGING_HPP
+#define WILT_IMAGING_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "narray.hpp"
+#include "algorithms.hpp"
+#include "indexing.hpp"
+#include "parallel.hpp"
+
+namespace wilt
+{
+  //////////////////////////////////////////////////////////////////////////////
+  // This class is designed to compute the sums of arbitrary boxes of an
+  // N-dimensional array in constant time.
+  //
+  // This class works by keeping a summed-area table, where each element holds
+  // the sum of all source elements with lower or equal positions in every
+  // dimension. The table is padded with a leading row of zeros along each
+  // dimension so that the sum of any box can be computed from the 2^N corners
+  // of the box without any edge cases.
+  //
+  // The template parameter `T` is the type the sums are computed in and can be
+  // different than the element type of the source array. It should be chosen
+  // so that the sum of the whole array does not overflow.
+
+  template <class T, std::size_t N>
+  class IntegralImage
+  {
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // TYPE DEFINITIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    using value_type = T;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    // PRIVATE MEMBERS
+    ////////////////////////////////////////////////////////////////////////////
+
+    NArray<T, N> table_; // summed-area table, padded by one in each dimension
+    Point<N> sizes_;     // dimension sizes of the source array
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // CONSTRUCTORS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Default constructor, makes an empty integral image
+    IntegralImage() noexcept;
+
+    // Creates the integral image from the elements of 'arr', which are
+    // converted to 'T' before being summed
+    //
+    // NOTE: the dimensions are scanned in parallel when enabled
+    template <class U>
+    explicit IntegralImage(const NArray<U, N>& arr);
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // QUERY FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Gets the dimension sizes of the source array
+    const Point<N>& sizes() const noexcept;
+
+    // Whether there is no source data
+    bool empty() const noexcept;
+
+    // Gets the summed-area table, which is one larger than the source array in
+    // each dimension
+    NArray<const T, N> table() const noexcept;
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // ACCESS FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Gets the sum of the elements in the box at that location and size, the
+    // same elements as 'arr.subarray(loc, size)'
+    T sum(const Point<N>& loc, const Point<N>& size) const;
+    T sumUnchecked(const Point<N>& loc, const Point<N>& size) const noexcept;
+
+    // Gets the sums for many boxes at once. Each row of 'boxes' holds a box
+    // location followed by its size, so it must have 2*N columns.
+    //
+    // NOTE: the boxes are evaluated in parallel when enabled
+    NArray<T, 1> sums(const NArray<const pos_t, 2>& boxes) const;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    // PRIVATE FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    bool validBox_(const Point<N>& loc, const Point<N>& size) const noexcept;
+
+  }; // class IntegralImage
+
+  template <class T, std::size_t N>
+  IntegralImage<T, N>::IntegralImage() noexcept
+    : table_()
+    , sizes_()
+  {
+
+  }
+
+  template <class T, std::size_t N>
+  template <class U>
+  IntegralImage<T, N>::IntegralImage(const NArray<U, N>& arr)
+    : table_()
+    , sizes_()
+  {
+    if (arr.empty())
+      return;
+
+    sizes_ = arr.sizes();
+    table_ = NArray<T, N>(sizes_ + 1, T());
+
+    Point<N> ones;
+    ones.fill(1);
+    NArray<T, N> interior = table_.subarray(ones, sizes_);
+    unaryOp(interior, arr.asConst(), [](T& t, const U& u) { t = static_cast<T>(u); });
+
+    // scanning in-place is safe since each element is read before it's written
+    std::plus<T> op;
+    for (std::size_t i = 0; i < N; ++i)
+      wilt::detail::scan(interior, interior, i, static_cast<const T*>(nullptr), op);
+  }
+
+  template <class T, std::size_t N>
+  const Point<N>& IntegralImage<T, N>::sizes() const noexcept
+  {
+    return sizes_;
+  }
+
+  template <class T, std::size_t N>
+  bool IntegralImage<T, N>::empty() const noexcept
+  {
+    return table_.empty();
+  }
+
+  template <class T, std::size_t N>
+  NArray<const T, N> IntegralImage<T, N>::table() const noexcept
+  {
+    return table_;
+  }
+
+  template <class T, std::size_t N>
+  T IntegralImage<T, N>::sum(const Point<N>& loc, const Point<N>& size) const
+  {
+    if (empty())
+      throw std::runtime_error("sum(loc, size): invalid when empty");
+    if (!validBox_(loc, size))
+      throw std::out_of_range("sum(loc, size): index out of bounds");
+
+    return sumUnchecked(loc, size);
+  }
+
+  template <class T, std::size_t N>
+  T IntegralImage<T, N>::sumUnchecked(const Point<N>& loc, const Point<N>& size) const noexcept
+  {
+    // each corner is included or excluded based on how many of its dimensions
+    // are at the low side of the box
+    T ret = T();
+    const T* base = table_.data();
+    for (std::size_t corner = 0; corner < (std::size_t(1) << N); ++corner)
+    {
+      const T* ptr = base;
+      std::size_t lows = 0;
+      for (std::size_t i = 0; i < N; ++i)
+      {
+        if (corner & (std::size_t(1) << i))
+          ptr += (loc[i] + size[i]) * table_.steps()[i];
+        else
+        {
+          ptr += loc[i] * table_.steps()[i];
+          ++lows;
+        }
+      }
+
+      if (lows % 2 == 0)
+        ret += *ptr;
+      else
+        ret -= *ptr;
+    }
+
+    return ret;
+  }
+
+  template <class T, std::size_t N>
+  NArray<T, 1> IntegralImage<T, N>::sums(const NArray<const pos_t, 2>& boxes) const
+  {
+    if (empty())
+      throw std::runtime_error("sums(boxes): invalid when empty");
+    if (boxes.empty())
+      return NArray<T, 1>();
+    if (boxes.sizes()[1] != (pos_t)(2 * N))
+      throw std::invalid_argument("sums(boxes): boxes must have 2*N columns");
+
+    auto getBox = [&boxes](pos_t n, Point<N>& loc, Point<N>& size) {
+      for (std::size_t i = 0; i < N; ++i)
+      {
+        loc[i] = boxes.atUnchecked({ n, (pos_t)i });
+        size[i] = boxes.atUnchecked({ n, (pos_t)(i + N) });
+      }
+    };
+
+    const pos_t count = boxes.sizes()[0];
+    for (pos_t n = 0; n < count; ++n)
+    {
+      Point<N> loc, size;
+      getBox(n, loc, size);
+      if (!validBox_(loc, size))
+        throw std::out_of_range("sums(boxes): box out of bounds");
+    }
+
+    NArray<T, 1> ret(Point<1>{ count });
+    wilt::detail::parallelFor(count, wilt::detail::PARALLEL_GRAIN >> N, [&](pos_t begin, pos_t end) {
+      for (pos_t n = begin; n < end; ++n)
+      {
+        Point<N> loc, size;
+        getBox(n, loc, size);
+        ret.atUnchecked(Point<1>{ n }) = sumUnchecked(loc, size);
+      }
+    });
+
+    return ret;
+  }
+
+  template <class T, std::size_t N>
+  bool IntegralImage<T, N>::validBox_(const Point<N>& loc, const Point<N>& size) const noexcept
+  {
+    for (std::size_t i = 0; i < N; ++i)
+      if (size[i] + loc[i] > sizes_[i] || size[i] <= 0 || loc[i] < 0 || loc[i] >= sizes_[i])
+        return false;
+
+    return true;
+  }
+
+  // The ways values between elements are computed when resizing:
+  //   - NEAREST = uses the nearest element
+  //   - LINEAR  = interpolates between the 2 nearest elements
+  //   - CUBIC   = interpolates between the 4 nearest elements
+  //   - AREA    = averages the elements covered when shrinking, the same as
+  //               LINEAR when growing
+  enum NArrayInterpolationType
+  {
+    NEAREST,
+    LINEAR,
+    CUBIC,
+    AREA
+  };
+
+namespace detail
+{
+  // The type resampling is computed in, float unless the elements are double.
+  template <class T>
+  using resample_type = typename std::conditional<std::is_same<T, double>::value, double, float>::type;
+
+  // The `ResampleTable` holds the precomputed coefficients to resample a
+  // dimension. Each output position is a weighted sum of 'taps' source
+  // positions, which are stored consecutively in 'index' and 'weights'.
+  template <class W>
+  struct ResampleTable
+  {
+    pos_t taps = 0;
+    std::vector<pos_t> index;
+    std::vector<W> weights;
+
+    pos_t size() const noexcept { return taps == 0 ? 0 : (pos_t)index.size() / taps; }
+
+    void add(pos_t i, double weight) { index.push_back(i); weights.push_back(W(weight)); }
+  };
+
+  // Creates the table to resample 'insize' elements to 'outsize' elements.
+  // Element centers are aligned, so source position 'x' maps to output
+  // position '(x + 0.5) * outsize / insize - 0.5'. Positions past the edges
+  // use the edge element.
+  template <class W>
+  ResampleTable<W> resizeTable(pos_t insize, pos_t outsize, NArrayInterpolationType type)
+  {
+    const double scale = double(insize) / double(outsize);
+    if (type == AREA && scale <= 1.0)
+      type = LINEAR;
+
+    ResampleTable<W> table;
+    switch (type)
+    {
+    case NEAREST:
+      table.taps = 1;
+      for (pos_t o = 0; o < outsize; ++o)
+        table.add(std::min(pos_t(std::floor((o + 0.5) * scale)), insize - 1), 1.0);
+      break;
+
+    case LINEAR:
+      table.taps = 2;
+      for (pos_t o = 0; o < outsize; ++o)
+      {
+        const double x = (o + 0.5) * scale - 0.5;
+        const pos_t x0 = pos_t(std::floor(x));
+        const double f = x - x0;
+        table.add(borderIndex(x0, insize, EDGE), 1.0 - f);
+        table.add(borderIndex(x0 + 1, insize, EDGE), f);
+      }
+      break;
+
+    case CUBIC:
+      table.taps = 4;
+      for (pos_t o = 0; o < outsize; ++o)
+      {
+        const double a = -0.75;
+        const double x = (o + 0.5) * scale - 0.5;
+        const pos_t x0 = pos_t(std::floor(x));
+        for (pos_t k = -1; k <= 2; ++k)
+        {
+          const double t = std::abs(x - double(x0 + k));
+          const double w = t <= 1.0 ? ((a + 2) * t - (a + 3)) * t * t + 1
+                                    : ((a * t - 5 * a) * t + 8 * a) * t - 4 * a;
+          table.add(borderIndex(x0 + k, insize, EDGE), w);
+        }
+      }
+      break;
+
+    case AREA:
+      table.taps = pos_t(std::ceil(scale)) + 1;
+      for (pos_t o = 0; o < outsize; ++o)
+      {
+        const double begin = o * scale;
+        const double end = (o + 1) * scale;
+        const pos_t x0 = pos_t(std::floor(begin));
+        for (pos_t k = 0; k < table.taps; ++k)
+        {
+          const double overlap = std::min(end, double(x0 + k + 1)) - std::max(begin, double(x0 + k));
+          table.add(borderIndex(x0 + k, insize, EDGE), std::max(overlap, 0.0) / scale);
+        }
+      }
+      break;
+    }
+
+    return table;
+  }
+
+  // Creates the table to blur 'insize' elements with a [1 4 6 4 1] / 16 kernel
+  // and keep every other element.
+  template <class W>
+  ResampleTable<W> pyrDownTable(pos_t insize)
+  {
+    const double kernel[] = { 1.0 / 16, 4.0 / 16, 6.0 / 16, 4.0 / 16, 1.0 / 16 };
+
+    ResampleTable<W> table;
+    table.taps = 5;
+    for (pos_t o = 0; o < (insize + 1) / 2; ++o)
+      for (pos_t k = 0; k < 5; ++k)
+        table.add(borderIndex(2 * o + k - 2, insize, REFLECT), kernel[k]);
+    return table;
+  }
+
+  // Creates the table to double 'insize' elements by inserting zeros between
+  // them and blurring with a [1 4 6 4 1] / 8 kernel.
+  template <class W>
+  ResampleTable<W> pyrUpTable(pos_t insize)
+  {
+    ResampleTable<W> table;
+    table.taps = 3;
+    for (pos_t i = 0; i < insize; ++i)
+    {
+      table.add(borderIndex(i - 1, insize, REFLECT), 1.0 / 8);
+      table.add(i, 6.0 / 8);
+      table.add(borderIndex(i + 1, insize, REFLECT), 1.0 / 8);
+      table.add(i, 4.0 / 8);
+      table.add(borderIndex(i + 1, insize, REFLECT), 4.0 / 8);
+      table.add(i, 0.0);
+    }
+    return table;
+  }
+
+  // Resamples the lanes along the last dimension of 'src' into 'dst', each
+  // output element is computed from its taps directly.
+  template <class W, std::size_t N>
+  void resampleLanes(const NArray<W, N>& src, const NArray<W, N>& dst, const ResampleTable<W>& table)
+  {
+    const pos_t outsize = table.size();
+    const pos_t lanes = (pos_t)dst.size() / outsize;
+    const pos_t srcstep = src.steps()[N-1];
+    const pos_t dststep = dst.steps()[N-1];
+    const auto sizes = dst.sizes().template high<N-1>();
+    const auto srcsteps = src.steps().template high<N-1>();
+    const auto dststeps = dst.steps().template high<N-1>();
+    const pos_t* index = table.index.data();
+    const W* weights = table.weights.data();
+
+    parallelFor(lanes, std::max<pos_t>(1, PARALLEL_GRAIN / (outsize * table.taps)), [&](pos_t begin, pos_t end) {
+      for (pos_t l = begin; l < end; ++l)
+      {
+        const W* s = src.data() + offsetOf(l, sizes, srcsteps);
+        W* d = dst.data() + offsetOf(l, sizes, dststeps);
+        for (pos_t o = 0; o < outsize; ++o)
+        {
+          W sum = W(0);
+          for (pos_t k = o * table.taps; k < (o + 1) * table.taps; ++k)
+            sum += weights[k] * s[index[k] * srcstep];
+          d[o * dststep] = sum;
+        }
+      }
+    });
+  }
+
+  // Resamples along 'dim' of 'src' into 'dst' by accumulating whole weighted
+  // slices, so the inner loops run over the contiguous trailing dimensions.
+  template <class W, std::size_t N>
+  void resampleSlices(const NArray<W, N>& src, const NArray<W, N>& dst, std::size_t dim, const ResampleTable<W>& table, std::true_type)
+  {
+    const pos_t outsize = table.size();
+    const pos_t slice = (pos_t)dst.size() / outsize;
+    const pos_t srcstep = src.steps()[dim];
+    const pos_t dststep = dst.steps()[dim];
+    const auto sizes = dst.sizes().removed(dim);
+    const auto srcsteps = src.steps().removed(dim);
+    const auto dststeps = dst.steps().removed(dim);
+
+    parallelFor(outsize, std::max<pos_t>(1, PARALLEL_GRAIN / (slice * table.taps)), [&](pos_t begin, pos_t end) {
+      for (pos_t o = begin; o < end; ++o)
+      {
+        W* d = dst.data() + o * dststep;
+        for (pos_t k = o * table.taps; k < (o + 1) * table.taps; ++k)
+        {
+          const W w = table.weights[k];
+          const W* s = src.data() + table.index[k] * srcstep;
+          if (k == o * table.taps)
+            binary<N-1>(sizes.data(), d, dststeps.data(), s, srcsteps.data(), [w](W& x, const W& y) { x = w * y; });
+          else if (w != W(0))
+            binary<N-1>(sizes.data(), d, dststeps.data(), s, srcsteps.data(), [w](W& x, const W& y) { x += w * y; });
+        }
+      }
+    });
+  }
+
+  template <class W, std::size_t N>
+  void resampleSlices(const NArray<W, N>&, const NArray<W, N>&, std::size_t, const ResampleTable<W>&, std::false_type)
+  {
+    // unreachable, a 1-dimensional array is always resampled by lanes
+  }
+
+  // Converts a computed value back to the element type, integer types are
+  // rounded and clamped to their range.
+  template <class T, class W>
+  T fromResampled(W val, std::true_type) noexcept
+  {
+    val = std::floor(val + W(0.5));
+    if (val <= W(std::numeric_limits<T>::lowest()))
+      return std::numeric_limits<T>::lowest();
+    if (val >= W(std::numeric_limits<T>::max()))
+      return std::numeric_limits<T>::max();
+    return T(val);
+  }
+
+  template <class T, class W>
+  T fromResampled(W val, std::false_type) noexcept
+  {
+    return T(val);
+  }
+
+  // Resamples each dimension of 'arr' by its table, dimensions with an empty
+  // table are left as is. Each dimension is a separate pass over the array.
+  template <class T, std::size_t N, class W>
+  NArray<typename std::remove_const<T>::type, N> resample(const NArray<T, N>& arr, const std::vector<ResampleTable<W>>& tables)
+  {
+    using U = typename std::remove_const<T>::type;
+
+    NArray<W, N> work(arr.sizes());
+    binary<N>(arr.sizes().data(), work.data(), work.steps().data(), arr.data(), arr.steps().data(), [](W& w, const T& t) { w = W(t); });
+
+    for (std::size_t d = N; d > 0; --d)
+    {
+      const ResampleTable<W>& table = tables[d-1];
+      if (table.taps == 0)
+        continue;
+
+      Point<N> sizes = work.sizes();
+      sizes[d-1] = table.size();
+      NArray<W, N> next(sizes);
+      if (d == N)
+        resampleLanes(work, next, table);
+      else
+        resampleSlices(work, next, d-1, table, std::integral_constant<bool, (N > 1)>());
+      work = next;
+    }
+
+    NArray<U, N> ret(work.sizes());
+    binary<N>(work.sizes().data(), ret.data(), ret.steps().data(), work.data(), work.steps().data(),
+      [](U& u, const W& w) { u = fromResampled<U>(w, std::is_integral<U>()); });
+    return ret;
+  }
+
+} // namespace detail
+
+  //! @brief         resamples an array to a new size
+  //! @param[in]     arr - the source array
+  //! @param[in]     newSize - the size of the result
+  //! @param[in]     type - how the new elements are interpolated
+  //! @return        a new array of size 'newSize'
+  //! @throws        std::invalid_argument if newSize is not valid
+  //!
+  //! Each dimension that changes size is resampled in a separate pass with
+  //! precomputed coefficients, so an image with channels in the last dimension
+  //! keeps them separate by keeping that size the same. Values are computed in
+  //! float (or double for double elements) and integer results are rounded and
+  //! clamped to their range. Passes run in parallel when enabled.
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> resize(const NArray<T, N>& arr, const Point<N>& newSize, NArrayInterpolationType type)
+  {
+    using W = detail::resample_type<typename std::remove_const<T>::type>;
+
+    if (!detail::validSize(newSize))
+      throw std::invalid_argument("resize(arr, newSize, type): newSize is not valid");
+    if (arr.empty())
+      throw std::invalid_argument("resize(arr, newSize, type): arr must not be empty");
+
+    std::vector<detail::ResampleTable<W>> tables(N);
+    for (std::size_t i = 0; i < N; ++i)
+      if (newSize[i] != arr.sizes()[i])
+        tables[i] = detail::resizeTable<W>(arr.sizes()[i], newSize[i], type);
+
+    return detail::resample(arr, tables);
+  }
+
+  //! @brief         blurs and halves the first two dimensions of an array
+  //! @param[in]     arr - the source array
+  //! @return        a new array with the first two dimensions halved, rounded
+  //!                up
+  //!
+  //! The array is blurred with a 5x5 Gaussian kernel before every other
+  //! element is kept, which avoids the aliasing of 'skipX(2).skipY(2)'. Only
+  //! the first two dimensions are changed so that further dimensions can hold
+  //! channels.
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> pyrDown(const NArray<T, N>& arr)
+  {
+    using W = detail::resample_type<typename std::remove_const<T>::type>;
+
+    if (arr.empty())
+      return NArray<typename std::remove_const<T>::type, N>();
+
+    std::vector<detail::ResampleTable<W>> tables(N);
+    for (std::size_t i = 0; i < N && i < 2; ++i)
+      tables[i] = detail::pyrDownTable<W>(arr.sizes()[i]);
+
+    return detail::resample(arr, tables);
+  }
+
+  //! @brief         doubles and blurs the first two dimensions of an array
+  //! @param[in]     arr - the source array
+  //! @return        a new array with the first two dimensions doubled
+  //!
+  //! New elements are interpolated with the same Gaussian kernel as pyrDown().
+  //! Only the first two dimensions are changed so that further dimensions can
+  //! hold channels.
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> pyrUp(const NArray<T, N>& arr)
+  {
+    using W = detail::resample_type<typename std::remove_const<T>::type>;
+
+    if (arr.empty())
+      return NArray<typename std::remove_const<T>::type, N>();
+
+    std::vector<detail::ResampleTable<W>> tables(N);
+    for (std::size_t i = 0; i < N && i < 2; ++i)
+      tables[i] = detail::pyrUpTable<W>(arr.sizes()[i]);
+
+    return detail::resample(arr, tables);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // This class is designed to hold successively smaller versions of an array
+  // for coarse-to-fine processing.
+  //
+  // This class works by keeping the source array as the first level and each
+  // following level is made from the last by pyrDown(), halving the first two
+  // dimensions.
+
+  template <class T, std::size_t N>
+  class GaussianPyramid
+  {
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // TYPE DEFINITIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    using value_type = T;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    // PRIVATE MEMBERS
+    ////////////////////////////////////////////////////////////////////////////
+
+    std::vector<NArray<T, N>> levels_; // the source array followed by each level
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // CONSTRUCTORS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Default constructor, makes an empty pyramid
+    GaussianPyramid() noexcept;
+
+    // Creates a pyramid with 'levels' levels, including the source array which
+    // is shared rather than copied
+    GaussianPyramid(const NArray<T, N>& arr, std::size_t levels);
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // QUERY FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Gets the number of levels, including the source array
+    std::size_t levels() const noexcept;
+    bool empty() const noexcept;
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // ACCESS FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Gets the level, where level 0 is the source array, will throw if out of
+    // bounds
+    const NArray<T, N>& level(std::size_t n) const;
+
+  }; // class GaussianPyramid
+
+  template <class T, std::size_t N>
+  GaussianPyramid<T, N>::GaussianPyramid() noexcept
+    : levels_()
+  {
+
+  }
+
+  template <class T, std::size_t N>
+  GaussianPyramid<T, N>::GaussianPyramid(const NArray<T, N>& arr, std::size_t levels)
+    : levels_()
+  {
+    if (arr.empty())
+      throw std::invalid_argument("GaussianPyramid(arr, levels): arr must not be empty");
+    if (levels == 0)
+      throw std::invalid_argument("GaussianPyramid(arr, levels): levels must be positive");
+
+    levels_.reserve(levels);
+    levels_.push_back(arr);
+    while (levels_.size() < levels)
+      levels_.push_back(pyrDown(levels_.back()));
+  }
+
+  template <class T, std::size_t N>
+  std::size_t GaussianPyramid<T, N>::levels() const noexcept
+  {
+    return levels_.size();
+  }
+
+  template <class T, std::size_t N>
+  bool GaussianPyramid<T, N>::empty() const noexcept
+  {
+    return levels_.empty();
+  }
+
+  template <class T, std::size_t N>
+  const NArray<T, N>& GaussianPyramid<T, N>::level(std::size_t n) const
+  {
+    if (n >= levels_.size())
+      throw std::out_of_range("level(n): n out of bounds");
+
+    return levels_[n];
+  }
+
+} // namespace wilt
+
+#endif // !WILT_IMAGING_HPP
@@ -0,0 +1,784 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: indexing.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines functions that select or place elements of an NArray
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_INDEXING_HPP
+#define WILT_INDEXING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "narray.hpp"
+#include "algorithms.hpp"
+#include "parallel.hpp"
+
+namespace wilt
+{
+  // The ways positions outside of an array are resolved when padding:
+  //   - CONSTANT = uses a provided value           (vvv|abcd|vvv)
+  //   - EDGE     = repeats the nearest element     (aaa|abcd|ddd)
+  //   - REFLECT  = mirrors without the edge        (dcb|abcd|cba)
+  //   - WRAP     = repeats the array periodically  (bcd|abcd|abc)
+  enum NArrayBorderType
+  {
+    CONSTANT,
+    EDGE,
+    REFLECT,
+    WRAP
+  };
+
+namespace detail
+{
+  // Gets the position within [0, n) that 'i' resolves to with the border type,
+  // or -1 if it resolves to the constant value.
+  inline pos_t borderIndex(pos_t i, pos_t n, NArrayBorderType type) noexcept
+  {
+    if (i >= 0 && i < n)
+      return i;
+
+    switch (type)
+    {
+    case EDGE:
+      return i < 0 ? 0 : n - 1;
+    case REFLECT:
+      if (n == 1)
+        return 0;
+      i %= 2 * (n - 1);
+      if (i < 0)
+        i += 2 * (n - 1);
+      return i < n ? i : 2 * (n - 1) - i;
+    case WRAP:
+      i %= n;
+      return i < 0 ? i + n : i;
+    default:
+      return -1;
+    }
+  }
+
+  // Calls 'func(offset1, offset2, n)' on each run of consecutive elements
+  // covering elements 'begin' to 'end' of two arrays with the same 'sizes',
+  // where the offsets are to the first element of the run in each array. The
+  // arrays should be condensed first so the runs are as long as possible.
+  template <std::size_t N, class Function>
+  void forRuns(const Point<N>& sizes, const Point<N>& steps1, const Point<N>& steps2, pos_t begin, pos_t end, Function& func)
+  {
+    const pos_t length = sizes[N-1];
+    const auto outersizes = sizes.removed(N-1);
+    const auto outersteps1 = steps1.removed(N-1);
+    const auto outersteps2 = steps2.removed(N-1);
+
+    while (begin < end)
+    {
+      const pos_t row = begin / length;
+      const pos_t col = begin % length;
+      const pos_t n = std::min(length - col, end - begin);
+      func(offsetOf(row, outersizes, outersteps1) + col * steps1[N-1],
+           offsetOf(row, outersizes, outersteps2) + col * steps2[N-1], n);
+      begin += n;
+    }
+  }
+
+  // Splits the elements of 'mask' into chunks and counts the set elements in
+  // each. The counts are replaced by the number of set elements before each
+  // chunk and the total is returned. This is the first half of the
+  // count-then-write scheme used to place the results of masked operations
+  // without synchronization.
+  template <class B, std::size_t N>
+  pos_t maskOffsets(const NArray<B, N>& mask, std::vector<pos_t>& offsets)
+  {
+    Point<N> sizes = mask.sizes();
+    Point<N> steps = mask.steps();
+    condense(sizes, steps);
+
+    const pos_t count = (pos_t)mask.size();
+    parallelChunks(count, offsets.size(), [&](std::size_t c, pos_t begin, pos_t end) {
+      pos_t total = 0;
+      auto func = [&](const B* data, pos_t step, pos_t n) {
+        for (pos_t i = 0; i < n; ++i)
+          total += data[i * step] ? 1 : 0;
+      };
+      forRuns(mask.data(), sizes, steps, begin, end, func);
+      offsets[c] = total;
+    });
+
+    pos_t total = 0;
+    for (pos_t& offset : offsets)
+    {
+      pos_t n = offset;
+      offset = total;
+      total += n;
+    }
+    return total;
+  }
+
+  // Copies the slabs along 'dim' selected by 'indices' between 'src' and
+  // 'dst'. If 'gather' is true, slab 'indices[i]' of 'src' is copied to slab
+  // 'i' of 'dst', otherwise slab 'i' of 'src' is copied to slab 'indices[i]'
+  // of 'dst'. Slabs that are contiguous in both arrays are copied as a single
+  // block. The slabs are only copied in parallel if 'parallel' is true.
+  template <class T, class U, std::size_t N>
+  void copySlabs(const NArray<T, N>& src, const NArray<U, N>& dst, std::size_t dim, const NArray<const pos_t, 1>& indices, bool gather, bool parallel, std::true_type)
+  {
+    const pos_t count = (pos_t)indices.size();
+    const pos_t indexstep = indices.steps()[0];
+    const pos_t srcstep = src.steps()[dim];
+    const pos_t dststep = dst.steps()[dim];
+    const pos_t slab = (pos_t)src.size() / src.sizes()[dim];
+
+    auto sizes = src.sizes().removed(dim);
+    auto srcsteps = src.steps().removed(dim);
+    auto dststeps = dst.steps().removed(dim);
+    condense(sizes, srcsteps, dststeps);
+    const bool contiguous = sizes[N-2] == slab && srcsteps[N-2] == 1 && dststeps[N-2] == 1;
+
+    parallelFor(count, parallel ? std::max<pos_t>(1, PARALLEL_GRAIN / slab) : count, [&](pos_t begin, pos_t end) {
+      for (pos_t i = begin; i < end; ++i)
+      {
+        const pos_t j = indices.data()[i * indexstep];
+        const T* s = src.data() + (gather ? j : i) * srcstep;
+        U* d = dst.data() + (gather ? i : j) * dststep;
+        if (contiguous)
+          std::copy(s, s + slab, d);
+        else
+          binary<N-1>(sizes.data(), d, dststeps.data(), s, srcsteps.data(), [](U& u, const T& t) { u = t; });
+      }
+    });
+  }
+
+  template <class T, class U, std::size_t N>
+  void copySlabs(const NArray<T, N>& src, const NArray<U, N>& dst, std::size_t, const NArray<const pos_t, 1>& indices, bool gather, bool parallel, std::false_type)
+  {
+    // a 1-dimensional array has single element slabs
+    const pos_t count = (pos_t)indices.size();
+    const pos_t indexstep = indices.steps()[0];
+    const pos_t srcstep = src.steps()[0];
+    const pos_t dststep = dst.steps()[0];
+
+    parallelFor(count, parallel ? PARALLEL_GRAIN : count, [&](pos_t begin, pos_t end) {
+      for (pos_t i = begin; i < end; ++i)
+      {
+        const pos_t j = indices.data()[i * indexstep];
+        dst.data()[(gather ? i : j) * dststep] = src.data()[(gather ? j : i) * srcstep];
+      }
+    });
+  }
+
+  // Checks that no index appears more than once, every index must be within
+  // [0, size).
+  inline bool uniqueIndices(const NArray<const pos_t, 1>& indices, pos_t size)
+  {
+    std::vector<bool> seen((std::size_t)size);
+    for (pos_t index : indices)
+    {
+      if (seen[(std::size_t)index])
+        return false;
+      seen[(std::size_t)index] = true;
+    }
+    return true;
+  }
+
+  // Checks that every index is within [0, size).
+  inline bool validIndices(const NArray<const pos_t, 1>& indices, pos_t size) noexcept
+  {
+    for (pos_t index : indices)
+      if (index < 0 || index >= size)
+        return false;
+    return true;
+  }
+
+  // Copies 'src' into 'dst', which must be the same size. The arrays are
+  // condensed first and copied as a single block if they are both contiguous
+  // and in the same order.
+  template <class T, class U, std::size_t N>
+  void copyArray(const NArray<T, N>& src, const NArray<U, N>& dst)
+  {
+    Point<N> sizes = src.sizes();
+    Point<N> srcsteps = src.steps();
+    Point<N> dststeps = dst.steps();
+    condense(sizes, srcsteps, dststeps);
+
+    const pos_t count = (pos_t)src.size();
+    if (sizes[N-1] == count && srcsteps[N-1] == 1 && dststeps[N-1] == 1)
+      std::copy(src.data(), src.data() + count, dst.data());
+    else
+      binary<N>(sizes.data(), dst.data(), dststeps.data(), src.data(), srcsteps.data(), [](U& u, const T& t) { u = t; });
+  }
+
+  // Concatenates the 'count' arrays along 'dim', skipping empty arrays. The
+  // arrays are copied in parallel when enabled.
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> concat(std::size_t dim, const NArray<T, N>* arrs, std::size_t count)
+  {
+    using U = typename std::remove_const<T>::type;
+
+    if (dim >= N)
+      throw std::out_of_range("concat(dim, arrs): dim out of bounds");
+
+    Point<N> sizes;
+    std::vector<pos_t> offsets(count);
+    pos_t total = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      offsets[i] = total;
+      if (arrs[i].empty())
+        continue;
+
+      if (total == 0)
+        sizes = arrs[i].sizes();
+      else if (arrs[i].sizes().removed(dim) != sizes.removed(dim))
+        throw std::invalid_argument("concat(dim, arrs): dimensions must match except along dim");
+      total += arrs[i].sizes()[dim];
+    }
+    if (total == 0)
+      return NArray<U, N>();
+
+    sizes[dim] = total;
+    NArray<U, N> ret(sizes);
+
+    const pos_t grain = std::max<pos_t>(1, PARALLEL_GRAIN * (pos_t)count / (pos_t)ret.size());
+    parallelFor((pos_t)count, grain, [&](pos_t begin, pos_t end) {
+      for (pos_t i = begin; i < end; ++i)
+        if (!arrs[i].empty())
+          copyArray(arrs[i], ret.range(dim, offsets[i], arrs[i].sizes()[dim]));
+    });
+
+    return ret;
+  }
+
+  // Stacks the 'count' arrays along a new dimension 'dim'. The arrays are
+  // copied in parallel when enabled.
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N+1> stack(std::size_t dim, const NArray<T, N>* arrs, std::size_t count)
+  {
+    using U = typename std::remove_const<T>::type;
+
+    if (dim > N)
+      throw std::out_of_range("stack(dim, arrs): dim out of bounds");
+    if (count == 0)
+      return NArray<U, N+1>();
+    for (std::size_t i = 0; i < count; ++i)
+      if (arrs[i].empty() || arrs[i].sizes() != arrs[0].sizes())
+        throw std::invalid_argument("stack(dim, arrs): arrays must be non-empty and the same size");
+
+    NArray<U, N+1> ret(arrs[0].sizes().inserted(dim, (pos_t)count));
+
+    const pos_t grain = std::max<pos_t>(1, PARALLEL_GRAIN / (pos_t)arrs[0].size());
+    parallelFor((pos_t)count, grain, [&](pos_t begin, pos_t end) {
+      for (pos_t i = begin; i < end; ++i)
+        copyArray(arrs[i], NArray<U, N>(ret.slice(dim, i)));
+    });
+
+    return ret;
+  }
+
+} // namespace detail
+
+  //////////////////////////////////////////////////////////////////////////////
+  // This class is designed to read an NArray as if it were padded infinitely in
+  // every direction, without making a padded copy.
+  //
+  // This class works by keeping a reference to the array and resolving any
+  // location outside of it by the border type on each access. This makes it
+  // suitable for stencils that read a small neighborhood around each element,
+  // where padding the whole array first would mean an extra allocation and
+  // copy. For bulk access, pad() is faster.
+
+  template <class T, std::size_t N>
+  class PaddedView
+  {
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // TYPE DEFINITIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    using value_type = typename std::remove_const<T>::type;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    // PRIVATE MEMBERS
+    ////////////////////////////////////////////////////////////////////////////
+
+    NArray<T, N> arr_;         // the array being padded
+    NArrayBorderType type_;    // how locations outside the array are resolved
+    value_type value_;         // the value outside the array, if CONSTANT
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // CONSTRUCTORS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Creates a view of the array with the border type and value, the array
+    // must not be empty
+    PaddedView(const NArray<T, N>& arr, NArrayBorderType type, const value_type& value = value_type());
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // QUERY FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Functions for getting the padded array and how it is padded
+    const NArray<T, N>& source() const noexcept;
+    const Point<N>& sizes() const noexcept;
+    NArrayBorderType type() const noexcept;
+    const value_type& value() const noexcept;
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    // ACCESS FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Gets the element at the location, which can be outside of the array
+    const value_type& at(const Point<N>& loc) const noexcept;
+
+  }; // class PaddedView
+
+  template <class T, std::size_t N>
+  PaddedView<T, N>::PaddedView(const NArray<T, N>& arr, NArrayBorderType type, const value_type& value)
+    : arr_(arr)
+    , type_(type)
+    , value_(value)
+  {
+    if (arr.empty())
+      throw std::invalid_argument("PaddedView(arr, type, value): arr must not be empty");
+  }
+
+  template <class T, std::size_t N>
+  const NArray<T, N>& PaddedView<T, N>::source() const noexcept
+  {
+    return arr_;
+  }
+
+  template <class T, std::size_t N>
+  const Point<N>& PaddedView<T, N>::sizes() const noexcept
+  {
+    return arr_.sizes();
+  }
+
+  template <class T, std::size_t N>
+  NArrayBorderType PaddedView<T, N>::type() const noexcept
+  {
+    return type_;
+  }
+
+  template <class T, std::size_t N>
+  const typename PaddedView<T, N>::value_type& PaddedView<T, N>::value() const noexcept
+  {
+    return value_;
+  }
+
+  template <class T, std::size_t N>
+  const typename PaddedView<T, N>::value_type& PaddedView<T, N>::at(const Point<N>& loc) const noexcept
+  {
+    Point<N> pos;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      pos[i] = detail::borderIndex(loc[i], arr_.sizes()[i], type_);
+      if (pos[i] < 0)
+        return value_;
+    }
+
+    return arr_.atUnchecked(pos);
+  }
+
+  //! @brief         copies the elements of an array where a mask is set
+  //! @param[in]     arr - the source array
+  //! @param[in]     mask - the mask, must be the same size as 'arr'
+  //! @return        a 1D array of the selected elements, in order
+  //! @throws        std::invalid_argument if the sizes don't match
+  //!
+  //! Elements are selected in parallel when enabled. Each thread counts the set
+  //! elements in its part of the mask, the counts are summed to get where each
+  //! thread should start writing, and then each thread copies its elements.
+  template <class T, class B, std::size_t N>
+  NArray<typename std::remove_const<T>::type, 1> compact(const NArray<T, N>& arr, const NArray<B, N>& mask)
+  {
+    static_assert(std::is_same<typename std::remove_const<B>::type, bool>::value, "compact(arr, mask): mask must be bool");
+
+    using U = typename std::remove_const<T>::type;
+
+    if (arr.sizes() != mask.sizes())
+      throw std::invalid_argument("compact(arr, mask): dimensions must match");
+    if (arr.empty())
+      return NArray<U, 1>();
+
+    const pos_t count = (pos_t)arr.size();
+    std::vector<pos_t> offsets(detail::chunkCount(count, detail::PARALLEL_GRAIN));
+    const pos_t total = detail::maskOffsets(mask, offsets);
+    if (total == 0)
+      return NArray<U, 1>();
+
+    Point<N> sizes = arr.sizes();
+    Point<N> arrsteps = arr.steps();
+    Point<N> masksteps = mask.steps();
+    detail::condense(sizes, arrsteps, masksteps);
+
+    NArray<U, 1> ret(Point<1>{ total });
+    detail::parallelChunks(count, offsets.size(), [&](std::size_t c, pos_t begin, pos_t end) {
+      U* dst = ret.data() + offsets[c];
+      auto func = [&](pos_t arroffset, pos_t maskoffset, pos_t n) {
+        const T* src = arr.data() + arroffset;
+        const B* set = mask.data() + maskoffset;
+        for (pos_t i = 0; i < n; ++i)
+          if (set[i * masksteps[N-1]])
+            *dst++ = src[i * arrsteps[N-1]];
+      };
+      detail::forRuns(sizes, arrsteps, masksteps, begin, end, func);
+    });
+
+    return ret;
+  }
+
+  //! @brief         gets the positions where a mask is set
+  //! @param[in]     mask - the mask
+  //! @return        a 2D array with a row for each set element, in order,
+  //!                holding its position in 'mask'
+  //!
+  //! Positions are found in parallel when enabled, using the same count then
+  //! write scheme as compact().
+  template <class B, std::size_t N>
+  NArray<pos_t, 2> where(const NArray<B, N>& mask)
+  {
+    static_assert(std::is_same<typename std::remove_const<B>::type, bool>::value, "where(mask): mask must be bool");
+
+    if (mask.empty())
+      return NArray<pos_t, 2>();
+
+    const pos_t count = (pos_t)mask.size();
+    std::vector<pos_t> offsets(detail::chunkCount(count, detail::PARALLEL_GRAIN));
+    const pos_t total = detail::maskOffsets(mask, offsets);
+    if (total == 0)
+      return NArray<pos_t, 2>();
+
+    const Point<N> sizes = mask.sizes();
+    const pos_t length = sizes[N-1];
+    const pos_t step = mask.steps()[N-1];
+
+    NArray<pos_t, 2> ret({ total, (pos_t)N });
+    detail::parallelChunks(count, offsets.size(), [&](std::size_t c, pos_t begin, pos_t end) {
+      pos_t* dst = ret.data() + offsets[c] * (pos_t)N;
+      while (begin < end)
+      {
+        Point<N> pos;
+        pos_t row = begin / length;
+        for (std::size_t i = N-1; i > 0; --i)
+        {
+          pos[i-1] = row % sizes[i-1];
+          row /= sizes[i-1];
+        }
+
+        const pos_t col = begin % length;
+        const pos_t n = std::min(length - col, end - begin);
+        pos[N-1] = col;
+
+        const B* set = &mask.atUnchecked(pos);
+        for (pos_t i = 0; i < n; ++i)
+        {
+          if (set[i * step])
+          {
+            for (std::size_t j = 0; j < N-1; ++j)
+              *dst++ = pos[j];
+            *dst++ = col + i;
+          }
+        }
+        begin += n;
+      }
+    });
+
+    return ret;
+  }
+
+  //! @brief         copies values in order into an array where a mask is set
+  //! @param[in]     dst - the destination array
+  //! @param[in]     mask - the mask, must be the same size as 'dst'
+  //! @param[in]     values - the values to place, must have as many elements
+  //!                as 'mask' has set elements
+  //! @throws        std::invalid_argument if the sizes don't match
+  //!
+  //! This is the inverse of compact(). Elements are placed in parallel when
+  //! enabled, using the same count then write scheme.
+  template <class T, class B, class U, std::size_t N>
+  void scatter(const NArray<T, N>& dst, const NArray<B, N>& mask, const NArray<U, 1>& values)
+  {
+    static_assert(!std::is_const<T>::value, "scatter(dst, mask, values): invalid when element type is const");
+    static_assert(std::is_same<typename std::remove_const<B>::type, bool>::value, "scatter(dst, mask, values): mask must be bool");
+
+    if (dst.sizes() != mask.sizes())
+      throw std::invalid_argument("scatter(dst, mask, values): dimensions must match");
+
+    const pos_t count = (pos_t)dst.size();
+    std::vector<pos_t> offsets(detail::chunkCount(count, detail::PARALLEL_GRAIN));
+    const pos_t total = dst.empty() ? 0 : detail::maskOffsets(mask, offsets);
+    if (total != (pos_t)values.size())
+      throw std::invalid_argument("scatter(dst, mask, values): values must match the number of set elements");
+    if (total == 0)
+      return;
+
+    Point<N> sizes = dst.sizes();
+    Point<N> dststeps = dst.steps();
+    Point<N> masksteps = mask.steps();
+    detail::condense(sizes, dststeps, masksteps);
+
+    const pos_t valuestep = values.steps()[0];
+    detail::parallelChunks(count, offsets.size(), [&](std::size_t c, pos_t begin, pos_t end) {
+      const U* src = values.data() + offsets[c] * valuestep;
+      auto func = [&](pos_t dstoffset, pos_t maskoffset, pos_t n) {
+        T* out = dst.data() + dstoffset;
+        const B* set = mask.data() + maskoffset;
+        for (pos_t i = 0; i < n; ++i)
+        {
+          if (set[i * masksteps[N-1]])
+          {
+            out[i * dststeps[N-1]] = *src;
+            src += valuestep;
+          }
+        }
+      };
+      detail::forRuns(sizes, dststeps, masksteps, begin, end, func);
+    });
+  }
+
+  //! @brief         copies positions along a dimension of an array
+  //! @param[in]     arr - the source array
+  //! @param[in]     indices - the positions along 'dim' to copy, in order,
+  //!                positions can be repeated
+  //! @param[in]     dim - the dimension to select along
+  //! @return        an array of the same size except with a size of
+  //!                'indices.size()' along 'dim', where slice 'i' along 'dim'
+  //!                is a copy of slice 'indices[i]' of 'arr'
+  //! @throws        std::out_of_range if dim or any index is out of bounds
+  //!
+  //! Slices are copied in parallel when enabled, and slices that are
+  //! contiguous in both arrays are copied as a single block.
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> take(const NArray<T, N>& arr, const NArray<const pos_t, 1>& indices, std::size_t dim)
+  {
+    using U = typename std::remove_const<T>::type;
+
+    if (dim >= N)
+      throw std::out_of_range("take(arr, indices, dim): dim out of bounds");
+    if (!detail::validIndices(indices, arr.sizes()[dim]))
+      throw std::out_of_range("take(arr, indices, dim): index out of bounds");
+    if (indices.empty())
+      return NArray<U, N>();
+
+    Point<N> sizes = arr.sizes();
+    sizes[dim] = (pos_t)indices.size();
+
+    NArray<U, N> ret(sizes);
+    detail::copySlabs(arr, ret, dim, indices, true, true, std::integral_constant<bool, (N > 1)>());
+    return ret;
+  }
+
+  //! @brief         copies values into positions along a dimension of an array
+  //! @param[in]     dst - the destination array
+  //! @param[in]     indices - the positions along 'dim' to copy into
+  //! @param[in]     values - the values to copy, must be the same size as
+  //!                'dst' except with a size of 'indices.size()' along 'dim'
+  //! @param[in]     dim - the dimension to place along
+  //! @throws        std::out_of_range if dim or any index is out of bounds
+  //! @throws        std::invalid_argument if the sizes don't match
+  //!
+  //! Slice 'i' along 'dim' of 'values' is copied to slice 'indices[i]' of
+  //! 'dst'. This is the inverse of take(). If an index is repeated, the last of
+  //! its values is kept. Slices are copied in parallel when enabled unless an
+  //! index is repeated, and slices that are contiguous in both arrays are
+  //! copied as a single block.
+  template <class T, class U, std::size_t N>
+  void put(const NArray<T, N>& dst, const NArray<const pos_t, 1>& indices, const NArray<U, N>& values, std::size_t dim)
+  {
+    static_assert(!std::is_const<T>::value, "put(dst, indices, values, dim): invalid when element type is const");
+
+    if (dim >= N)
+      throw std::out_of_range("put(dst, indices, values, dim): dim out of bounds");
+    if (!detail::validIndices(indices, dst.sizes()[dim]))
+      throw std::out_of_range("put(dst, indices, values, dim): index out of bounds");
+    if (indices.empty())
+      return;
+
+    Point<N> sizes = dst.sizes();
+    sizes[dim] = (pos_t)indices.size();
+    if (values.sizes() != sizes)
+      throw std::invalid_argument("put(dst, indices, values, dim): dimensions must match");
+
+    // repeated indices would have multiple threads writing the same slice, so
+    // they are copied in order on one thread instead
+    const bool parallel = detail::uniqueIndices(indices, dst.sizes()[dim]);
+    detail::copySlabs(values, dst, dim, indices, false, parallel, std::integral_constant<bool, (N > 1)>());
+  }
+
+  //! @brief         joins arrays along an existing dimension
+  //! @param[in]     dim - the dimension to join along
+  //! @param[in]     arrs - the arrays to join, in order, must be the same size
+  //!                except along 'dim', empty arrays are skipped
+  //! @return        a new array holding a copy of the arrays
+  //! @throws        std::out_of_range if dim is out of bounds
+  //! @throws        std::invalid_argument if the sizes don't match
+  //!
+  //! The result is allocated once and each array is copied into its place as
+  //! a single block if both are contiguous, otherwise element-wise. Arrays are
+  //! copied in parallel when enabled.
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> concat(std::size_t dim, std::initializer_list<NArray<T, N>> arrs)
+  {
+    return detail::concat(dim, arrs.begin(), arrs.size());
+  }
+
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> concat(std::size_t dim, const std::vector<NArray<T, N>>& arrs)
+  {
+    return detail::concat(dim, arrs.data(), arrs.size());
+  }
+
+  //! @brief         joins arrays along a new dimension
+  //! @param[in]     dim - the position of the new dimension
+  //! @param[in]     arrs - the arrays to join, in order, must all be
+  //!                non-empty and the same size
+  //! @return        a new array where slice 'i' along 'dim' is a copy of the
+  //!                ith array
+  //! @throws        std::out_of_range if dim is out of bounds
+  //! @throws        std::invalid_argument if the sizes don't match
+  //!
+  //! Arrays are copied the same way as concat().
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N+1> stack(std::size_t dim, std::initializer_list<NArray<T, N>> arrs)
+  {
+    return detail::stack(dim, arrs.begin(), arrs.size());
+  }
+
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N+1> stack(std::size_t dim, const std::vector<NArray<T, N>>& arrs)
+  {
+    return detail::stack(dim, arrs.data(), arrs.size());
+  }
+
+  //! @brief         splits an array into consecutive ranges along a dimension
+  //! @param[in]     arr - the array to split
+  //! @param[in]     dim - the dimension to split along
+  //! @param[in]     sizes - the size of each range along 'dim', must be
+  //!                positive and add up to the size of 'arr' along 'dim'
+  //! @return        the ranges, in order, which share data with 'arr'
+  //! @throws        std::out_of_range if dim is out of bounds
+  //! @throws        std::invalid_argument if the sizes are not valid
+  template <class T, std::size_t N>
+  std::vector<NArray<T, N>> split(const NArray<T, N>& arr, std::size_t dim, const std::vector<pos_t>& sizes)
+  {
+    if (dim >= N)
+      throw std::out_of_range("split(arr, dim, sizes): dim out of bounds");
+
+    pos_t total = 0;
+    for (pos_t size : sizes)
+    {
+      if (size <= 0)
+        throw std::invalid_argument("split(arr, dim, sizes): sizes must be positive");
+      total += size;
+    }
+    if (total != arr.sizes()[dim])
+      throw std::invalid_argument("split(arr, dim, sizes): sizes must add up to the dimension");
+
+    std::vector<NArray<T, N>> ret;
+    ret.reserve(sizes.size());
+
+    pos_t start = 0;
+    for (pos_t size : sizes)
+    {
+      ret.push_back(arr.range(dim, start, size));
+      start += size;
+    }
+    return ret;
+  }
+
+  //! @brief         copies an array with padding around it
+  //! @param[in]     arr - the source array
+  //! @param[in]     before - the amount of padding before each dimension
+  //! @param[in]     after - the amount of padding after each dimension
+  //! @param[in]     type - how the padding is filled
+  //! @param[in]     value - the padding value if 'type' is CONSTANT
+  //! @return        a new array of size 'before + arr.sizes() + after' with
+  //!                'arr' copied at 'before'
+  //! @throws        std::invalid_argument if any padding is negative
+  //!
+  //! The interior is copied as a whole, as a single block if possible, and
+  //! then the padding is filled one dimension at a time by copying the slices
+  //! the border type resolves to. Padding can be larger than the array.
+  template <class T, std::size_t N>
+  NArray<typename std::remove_const<T>::type, N> pad(const NArray<T, N>& arr, const Point<N>& before, const Point<N>& after, NArrayBorderType type, const typename std::remove_const<T>::type& value = typename std::remove_const<T>::type())
+  {
+    using U = typename std::remove_const<T>::type;
+
+    for (std::size_t i = 0; i < N; ++i)
+      if (before[i] < 0 || after[i] < 0)
+        throw std::invalid_argument("pad(arr, before, after, type, value): padding must not be negative");
+    if (arr.empty())
+      return NArray<U, N>();
+
+    const Point<N> sizes = arr.sizes();
+    NArray<U, N> ret(before + sizes + after);
+    detail::copyArray(arr, ret.subarray(before, sizes));
+
+    // the padding along each dimension covers the full range of the previous
+    // dimensions, so that corners are filled from already padded slices
+    for (std::size_t d = 0; d < N; ++d)
+    {
+      NArray<U, N> view = ret;
+      for (std::size_t j = d + 1; j < N; ++j)
+        view = view.range(j, before[j], sizes[j]);
+
+      for (pos_t p = 0; p < view.sizes()[d]; ++p)
+      {
+        if (p == before[d])
+          p += sizes[d];
+        if (p == view.sizes()[d])
+          break;
+
+        const pos_t src = detail::borderIndex(p - before[d], sizes[d], type);
+        if (src < 0)
+          view.range(d, p, 1).setTo(value);
+        else
+          detail::copyArray(view.range(d, before[d] + src, 1), view.range(d, p, 1));
+      }
+    }
+
+    return ret;
+  }
+
+  //! @brief         creates a view that reads an array as if it were padded
+  //! @param[in]     arr - the source array, must not be empty
+  //! @param[in]     type - how locations outside the array are resolved
+  //! @param[in]     value - the value outside the array if 'type' is CONSTANT
+  //! @return        a view that resolves any location by the border type
+  template <class T, std::size_t N>
+  PaddedView<T, N> paddedView(const NArray<T, N>& arr, NArrayBorderType type, const typename std::remove_const<T>::type& value = typename std::remove_const<T>::type())
+  {
+    return PaddedView<T, N>(arr, type, value);
+  }
+
+} // namespace wilt
+
+#endif // !WILT_INDEXING_HPP
@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: memory.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines optional accounting of the memory held by arrays
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_MEMORY_HPP
+#define WILT_MEMORY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "point.hpp"
+
+// Registers data blocks and the arrays that view them if
+// `WILT_NARRAY_TRACK_MEMORY` is defined, otherwise does nothing and doesn't
+// evaluate the arguments.
+//
+// The macro must be defined the same way in every translation unit of a
+// program since it changes the bodies of inline functions and templates.
+#if defined(WILT_NARRAY_TRACK_MEMORY)
+#define WILT_NARRAY_TRACK_BLOCK(data, bytes) ::wilt::detail::MemoryRegistry::instance().addBlock(data, bytes)
+#define WILT_NARRAY_UNTRACK_BLOCK(data) ::wilt::detail::MemoryRegistry::instance().removeBlock(data)
+#define WILT_NARRAY_TRACK_VIEW(arr) ::wilt::detail::MemoryRegistry::instance().setView(&(arr), (arr).data(), (arr).sizes(), (arr).steps(), sizeof(*(arr).data()))
+#define WILT_NARRAY_UNTRACK_VIEW(arr) ::wilt::detail::MemoryRegistry::instance().removeView(&(arr))
+#else
+#define WILT_NARRAY_TRACK_BLOCK(data, bytes) ((void)sizeof(data), (void)sizeof(bytes))
+#define WILT_NARRAY_UNTRACK_BLOCK(data) ((void)0)
+#define WILT_NARRAY_TRACK_VIEW(arr) ((void)0)
+#define WILT_NARRAY_UNTRACK_VIEW(arr) ((void)0)
+#endif
+
+namespace wilt
+{
+  // Describes a live data block and how much of it live arrays can reach.
+  struct NArrayBlockInfo
+  {
+    const void* data;             // the start of the block
+    std::size_t bytes;            // the size of the block
+    std::size_t reachableBytes;   // the bytes spanned by arrays viewing it
+    std::size_t views;            // the number of arrays viewing it
+  };
+
+namespace detail
+{
+  //! @brief         gets the range of bytes that an array can reach
+  //! @param[in]     data - pointer to the first element
+  //! @param[in]     sizes - the dimensions of the array
+  //! @param[in]     steps - the steps of the array
+  //! @param[in]     elementSize - the size of each element in bytes
+  //! @return        the first byte and one past the last byte reached
+  template <std::size_t N>
+  std::pair<const char*, const char*> viewExtent(const void* data, const Point<N>& sizes, const Point<N>& steps, std::size_t elementSize) noexcept
+  {
+    pos_t lo = 0;
+    pos_t hi = 0;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      const pos_t span = (sizes[i] - 1) * steps[i];
+      if (span < 0)
+        lo += span;
+      else
+        hi += span;
+    }
+
+    const char* base = static_cast<const char*>(data);
+    return { base + lo * (pos_t)elementSize, base + (hi + 1) * (pos_t)elementSize };
+  }
+
+  // Keeps track of the live data blocks and the ranges that live arrays can
+  // reach, keyed by the address of the array.
+  class MemoryRegistry
+  {
+  public:
+    static MemoryRegistry& instance()
+    {
+      static MemoryRegistry registry;
+      return registry;
+    }
+
+    void addBlock(const void* data, std::size_t bytes)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      blocks_[static_cast<const char*>(data)] = bytes;
+    }
+
+    void removeBlock(const void* data)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      blocks_.erase(static_cast<const char*>(data));
+    }
+
+    template <std::size_t N>
+    void setView(const void* self, const void* data, const Point<N>& sizes, const Point<N>& steps, std::size_t elementSize)
+    {
+      if (!data)
+      {
+        removeView(self);
+        return;
+      }
+
+      auto extent = viewExtent(data, sizes, steps, elementSize);
+      std::lock_guard<std::mutex> lock(mutex_);
+      views_[self] = extent;
+    }
+
+    void removeView(const void* self)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      views_.erase(self);
+    }
+
+    std::vector<NArrayBlockInfo> blocks() const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      // group the view extents by the block they fall in
+      std::map<const char*, std::vector<std::pair<const char*, const char*>>> extents;
+      for (const auto& view : views_)
+      {
+        auto it = blocks_.upper_bound(view.second.first);
+        if (it == blocks_.begin())
+          continue;
+        --it;
+        if (view.second.first < it->first + it->second)
+          extents[it->first].push_back(view.second);
+      }
+
+      std::vector<NArrayBlockInfo> infos;
+      infos.reserve(blocks_.size());
+      for (const auto& block : blocks_)
+      {
+        NArrayBlockInfo info = { block.first, block.second, 0, 0 };
+
+        auto found = extents.find(block.first);
+        if (found != extents.end())
+        {
+          auto& ranges = found->second;
+          std::sort(ranges.begin(), ranges.end());
+          info.views = ranges.size();
+
+          // add up the union of the ranges
+          const char* covered = block.first;
+          for (const auto& range : ranges)
+          {
+            const char* begin = std::max(range.first, covered);
+            if (range.second > begin)
+            {
+              info.reachableBytes += range.second - begin;
+              covered = range.second;
+            }
+          }
+        }
+
+        infos.push_back(info);
+      }
+
+      return infos;
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::map<const char*, std::size_t> blocks_;
+    std::unordered_map<const void*, std::pair<const char*, const char*>> views_;
+  };
+
+} // namespace detail
+
+  //! @brief         gets the live data blocks when `WILT_NARRAY_TRACK_MEMORY`
+  //!                is defined
+  //! @return        information on each block, in address order
+  inline std::vector<NArrayBlockInfo> memoryBlocks()
+  {
+    return detail::MemoryRegistry::instance().blocks();
+  }
+
+  //! @brief         gets the blocks that are mostly kept alive by arrays that
+  //!                can only reach a small part of them
+  //! @param[in]     fraction - the largest reachable fraction of a block to
+  //!                report
+  //! @param[in]     minBytes - the smallest block size to report
+  //! @return        the pinned blocks, the most wasteful first
+  inline std::vector<NArrayBlockInfo> pinnedBlocks(double fraction = 0.25, std::size_t minBytes = 0)
+  {
+    std::vector<NArrayBlockInfo> pinned;
+    for (const NArrayBlockInfo& info : memoryBlocks())
+      if (info.bytes >= minBytes && (double)info.reachableBytes <= fraction * (double)info.bytes)
+        pinned.push_back(info);
+
+    std::sort(pinned.begin(), pinned.end(), [](const NArrayBlockInfo& a, const NArrayBlockInfo& b) {
+      return a.bytes - a.reachableBytes > b.bytes - b.reachableBytes;
+    });
+    return pinned;
+  }
+
+  //! @brief         writes a summary of the live blocks and the pinned ones
+  //! @param[in]     out - the stream to write to
+  //! @param[in]     fraction - the largest reachable fraction of a block to
+  //!                report as pinned
+  //! @param[in]     minBytes - the smallest block size to report as pinned
+  inline void writeMemoryReport(std::ostream& out, double fraction = 0.25, std::size_t minBytes = 0)
+  {
+    std::size_t bytes = 0;
+    std::size_t reachable = 0;
+    const std::vector<NArrayBlockInfo> blocks = memoryBlocks();
+    for (const NArrayBlockInfo& info : blocks)
+    {
+      bytes += info.bytes;
+      reachable += info.reachableBytes;
+    }
+
+    out << blocks.size() << " blocks, " << bytes << " bytes, " << reachable << " bytes reachable\n";
+    for (const NArrayBlockInfo& info : pinnedBlocks(fraction, minBytes))
+      out << "  pinned block " << info.data << ": " << info.reachableBytes << " of " << info.bytes
+          << " bytes reachable by " << info.views << " arrays\n";
+  }
+
+} // namespace wilt
+
+#endif // !WILT_MEMORY_HPP
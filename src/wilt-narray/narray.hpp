@@ -37,8 +37,11 @@
 #include <utility>
 
 #include "util.hpp"
+#include "checks.hpp"
 #include "point.hpp"
 #include "narraydatablock.hpp"
+#include "memory.hpp"
+#include "trace.hpp"
 
 namespace wilt
 {
@@ -48,6 +51,9 @@ namespace wilt
   // - defined below
   template <class T, std::size_t N, std::size_t M> class SubNArrays;
 
+  // - defined in "bitmask.hpp"
+  template <std::size_t N> class BitMask;
+
   //////////////////////////////////////////////////////////////////////////////
   // This class is designed to access a sequence of data and to manipulate it in
   // an N-dimensional manner.
@@ -139,6 +145,10 @@ namespace wilt
     NArray(const NArray<T, N>& arr) noexcept;
     NArray(NArray<T, N>&& arr) noexcept;
 
+    // Destructor, only does anything beyond releasing the data if
+    // `WILT_NARRAY_TRACK_MEMORY` is defined
+    ~NArray();
+
     // Copy and move constructor from 'T' to 'const T'
     //
     // NOTE: 'arr' is empty after being moved
@@ -149,11 +159,12 @@ namespace wilt
     NArray(NArray<U, N>&& arr) noexcept;
 
     // Creates an array of the given size, elements are default constructed.
-    explicit NArray(const Point<N>& size);
+    // The data is backed by the pages chosen by 'storage'.
+    explicit NArray(const Point<N>& size, NArrayStorageType storage = DEFAULT_PAGES);
 
     // Creates an array of the given size, elements are copy constructed from
-    // 'val'.
-    NArray(const Point<N>& size, const T& val);
+    // 'val'. The data is backed by the pages chosen by 'storage'.
+    NArray(const Point<N>& size, const T& val, NArrayStorageType storage = DEFAULT_PAGES);
 
     // Creates an array of the given size, elements are constructed or not 
     // based on 'type'
@@ -260,8 +271,13 @@ namespace wilt
     // Functions for determining the data organization for this array.
     //   - isContiguous = the array accesses data with no gaps
     //   - isAligned    = the array accesses data linearly
+    //   - isRepeated   = the array accesses the same data more than once due to
+    //                    a dimension with a zero step, like from 'repeat()'
+    //
+    // NOTE: a repeated array is never contiguous
     bool isContiguous() const noexcept;
     bool isAligned() const noexcept;
+    bool isRepeated() const noexcept;
 
   public:
     ////////////////////////////////////////////////////////////////////////////
@@ -299,6 +315,10 @@ namespace wilt
     ////////////////////////////////////////////////////////////////////////////
     // Functions that create a new array that references the shared data
     //
+    // The arguments are checked according to WILT_NARRAY_CHECKS. Each has an
+    // 'Unchecked' variant that never checks, for hot paths where the arguments
+    // are already known to be valid.
+    //
     // NOTE: any function that would return an NArray of dimension 0, will
     // instead return a T&.
 
@@ -323,6 +343,7 @@ namespace wilt
     NArray<T, N-1> sliceY(pos_t y) const;
     NArray<T, N-1> sliceZ(pos_t z) const;
     NArray<T, N-1> sliceW(pos_t w) const;
+    typename NArray<T, N-1>::exposed_type sliceUnchecked(std::size_t dim, pos_t n) const noexcept;
 
     // Gets the subarray with range along the specified dimension
     //   - dim = specified dimension
@@ -337,6 +358,7 @@ namespace wilt
     NArray<T, N> rangeY(pos_t start, pos_t length) const;
     NArray<T, N> rangeZ(pos_t start, pos_t length) const;
     NArray<T, N> rangeW(pos_t start, pos_t length) const;
+    NArray<T, N> rangeUnchecked(std::size_t dim, pos_t start, pos_t length) const noexcept;
 
     // Gets an NArray with the specified dimension reversed
     //   - dim = specified dimension
@@ -352,6 +374,7 @@ namespace wilt
     NArray<T, N> flipY() const;
     NArray<T, N> flipZ() const;
     NArray<T, N> flipW() const;
+    NArray<T, N> flipUnchecked(std::size_t dim) const noexcept;
 
     // Gets an NArray with skipping every 'n' indexes along that dimension,
     // optional 'start' that denotes where the skipping starts from
@@ -367,17 +390,20 @@ namespace wilt
     NArray<T, N> skipY(pos_t n, pos_t start = 0) const;
     NArray<T, N> skipZ(pos_t n, pos_t start = 0) const;
     NArray<T, N> skipW(pos_t n, pos_t start = 0) const;
+    NArray<T, N> skipUnchecked(std::size_t dim, pos_t n, pos_t start = 0) const noexcept;
 
     // Gets an NArray with two dimensions swapped
     //
     // NOTE: 'transpose()' is identical to 'transpose(0, 1)'
     NArray<T, N> transpose() const;
     NArray<T, N> transpose(std::size_t dim1, std::size_t dim2) const;
+    NArray<T, N> transposeUnchecked(std::size_t dim1, std::size_t dim2) const noexcept;
 
     // Gets the subarray at that location and size
     //
     // NOTE: can use chain of 'rangeN()' to get the same result
     NArray<T, N> subarray(const Point<N>& loc, const Point<N>& size) const;
+    NArray<T, N> subarrayUnchecked(const Point<N>& loc, const Point<N>& size) const noexcept;
 
     // Gets the array at that location. M must be less than N.
     template <std::size_t M>
@@ -401,6 +427,7 @@ namespace wilt
 
     // Creates an additional dimension of size {n} that repeats the same data
     NArray<T, N+1> repeat(pos_t n) const;
+    NArray<T, N+1> repeatUnchecked(pos_t n) const noexcept;
 
     // Creates an additional dimension that essentially creates a sliding window
     // along that dimension. It reduces that dimension by n+1 and creates a new
@@ -418,6 +445,7 @@ namespace wilt
     NArray<T, N+1> windowY(pos_t n) const;
     NArray<T, N+1> windowZ(pos_t n) const;
     NArray<T, N+1> windowW(pos_t n) const;
+    NArray<T, N+1> windowUnchecked(std::size_t dim, pos_t n) const noexcept;
 
     // creates a constant version of the NArray, not strictly necessary since a
     // conversion constructor exists but is still nice to have.
@@ -449,6 +477,15 @@ namespace wilt
     // size() times.
     NArray<typename std::remove_const<T>::type, N> clone() const;
 
+    // Copies the data referenced into a new NArray if the array can only reach
+    // less than 'threshold' of the data block it keeps alive, otherwise returns
+    // the array as-is. This lets small views of large arrays be held without
+    // holding onto the rest of the data.
+    //
+    // NOTE: 'threshold' must be between 0 and 1
+    // NOTE: arrays whose data isn't owned by the library are never copied
+    NArray<T, N> compacted(double threshold = 0.5) const;
+
     // Converts the NArray to a new data type either directly or with a
     // conversion function
     // 
@@ -472,6 +509,8 @@ namespace wilt
     void setTo(const T& val) const;
     void setTo(const NArray<const T, N>& arr, const NArray<const bool, N>& mask) const;
     void setTo(const T& val, const NArray<const bool, N>& mask) const;
+    void setTo(const NArray<const T, N>& arr, const BitMask<N>& mask) const;
+    void setTo(const T& val, const BitMask<N>& mask) const;
 
     // Clears the array by dropping its reference to the data, destructing it if
     // it was the last reference.
@@ -490,12 +529,6 @@ namespace wilt
     // PRIVATE FUNCTIONS
     ////////////////////////////////////////////////////////////////////////////
 
-    typename NArray<T, N-1>::exposed_type slice_(std::size_t dim, pos_t n) const noexcept;
-    NArray<T, N> range_(std::size_t dim, pos_t start, pos_t length) const noexcept;
-    NArray<T, N> flip_(std::size_t dim) const noexcept;
-    NArray<T, N> skip_(std::size_t dim, pos_t n, pos_t start) const noexcept;
-    NArray<T, N+1> window_(std::size_t dim, pos_t n) const noexcept;
-
     template <class U, class Converter>
     static void convertTo_(const wilt::NArray<T, N>& lhs, wilt::NArray<U, N>& rhs, Converter func);
 
@@ -565,11 +598,12 @@ namespace wilt
   template <class T, class U, class V, std::size_t N, class Operator>
   NArray<T, N> binaryOp(const NArray<U, N>& src1, const NArray<V, N>& src2, Operator op)
   {
+    WILT_NARRAY_TRACE_SCOPE("binaryOp", src1);
     NArray<T, N> ret(src1.sizes());
     wilt::detail::ternary<N>(ret.sizes().data(), 
       ret.data(), ret.steps().data(),
-      src1.data(), src1.steps().data(), 
-      src2.data(), src2.steps().data(), 
+      static_cast<const U*>(src1.data()), src1.steps().data(), 
+      static_cast<const V*>(src2.data()), src2.steps().data(), 
       [&op](T& t, const U& u, const V& v) { t = op(u, v); });
     return ret;
   }
@@ -584,6 +618,7 @@ namespace wilt
   template <class T, class U, class V, std::size_t N, class Operator>
   void binaryOp(NArray<T, N>& dst, const NArray<U, N>& src1, const NArray<V, N>& src2, Operator op)
   {
+    WILT_NARRAY_TRACE_SCOPE("binaryOp", dst);
     wilt::detail::ternary<N>(dst.sizes().data(), 
       dst.data(), dst.steps().data(), 
       src1.data(), src1.steps().data(), 
@@ -599,10 +634,11 @@ namespace wilt
   template <class T, class U, std::size_t N, class Operator>
   NArray<T, N> unaryOp(const NArray<U, N>& src, Operator op)
   {
+    WILT_NARRAY_TRACE_SCOPE("unaryOp", src);
     NArray<T, N> ret(src.sizes());
     wilt::detail::binary<N>(ret.sizes().data(), 
       ret.data(), ret.steps().data(), 
-      src.data(), src.steps().data(), 
+      static_cast<const U*>(src.data()), src.steps().data(), 
       [&op](T& t, const U& u){ t = op(u); });
     return ret;
   }
@@ -616,6 +652,7 @@ namespace wilt
   template <class T, class U, std::size_t N, class Operator>
   void unaryOp(NArray<T, N>& dst, const NArray<U, N>& src, Operator op)
   {
+    WILT_NARRAY_TRACE_SCOPE("unaryOp", dst);
     wilt::detail::binary<N>(dst.sizes().data(), 
       dst.data(), dst.steps().data(), 
       src.data(), src.steps().data(), 
@@ -633,7 +670,7 @@ namespace detail
   //! meaningful result
   //! Will fail if N==0
   template <std::size_t N>
-  Point<N> step(const Point<N>& sizes) noexcept
+  constexpr Point<N> step(const Point<N>& sizes) noexcept
   {
     Point<N> ret;
     ret[N-1] = 1;
@@ -651,7 +688,7 @@ namespace detail
   //! Will be zero if any dimension is zero
   //! Will fail if N==0
   template <std::size_t N>
-  pos_t size(const Point<N>& sizes) noexcept
+  constexpr pos_t size(const Point<N>& sizes) noexcept
   {
     pos_t ret = sizes[0];
     for (std::size_t i = 1; i < N; ++i)
@@ -660,7 +697,7 @@ namespace detail
   }
 
   template <std::size_t N>
-  bool validSize(const Point<N>& size) noexcept
+  constexpr bool validSize(const Point<N>& size) noexcept
   {
     for (std::size_t i = 0; i < N; ++i)
       if (size[i] <= 0)
@@ -676,7 +713,7 @@ namespace detail
   //!
   //! Is used exclusively in NArray::align() to create an aligned NArray
   template <std::size_t N>
-  pos_t align(Point<N>& sizes, Point<N>& steps) noexcept
+  constexpr pos_t align(Point<N>& sizes, Point<N>& steps) noexcept
   {
     pos_t offset = 0;
     for (std::size_t i = 0; i < N; ++i)
@@ -691,88 +728,13 @@ namespace detail
     {
       for (std::size_t j = i; j > 0 && steps[j] > steps[j-1]; --j)
       {
-        std::swap(steps[j], steps[j-1]);
-        std::swap(sizes[j], sizes[j-1]);
+        swapValues(steps[j], steps[j-1]);
+        swapValues(sizes[j], sizes[j-1]);
       }
     }
     return offset;
   }
 
-  //! @brief         Condenses a dim array and steps array into smaller arrays
-  //!                if able to
-  //! @param[in,out] sizes - dimension array as a point
-  //! @param[in,out] steps - step array as a point
-  //! @return        the dimension of the arrays after condensing, values at or
-  //!                after n in the arrays are junk
-  //!
-  //! Is used when applying operations on arrays to effectively reduce the
-  //! dimensionality of the data which will reduce loops and function calls.
-  //! Condensing the dim and step arrays from an aligned and continuous NArray
-  //! should result in return=1, sizes=size(sizes), steps={1}
-  //! Dimension array should all be positive and non-zero and step arrays must 
-  //! be valid to produce a meaningful result
-  template <std::size_t N>
-  std::size_t condense(Point<N>& sizes, Point<N>& steps) noexcept
-  {
-    std::size_t j = N-1;
-    for (std::size_t i = N-1; i > 0; --i)
-    {
-      if (steps[j] * sizes[j] == steps[i-1])
-      {
-        sizes[j] *= sizes[i-1];
-      }
-      else
-      {
-        --j;
-        sizes[j] = sizes[i-1];
-        steps[j] = steps[i-1];
-      }
-    }
-    for (std::size_t i = 0; i < j; ++i)
-    {
-      sizes[i] = 1;
-      steps[i] = std::abs(sizes[j] * steps[j]);
-    }
-
-    return N - j;
-  }
-
-  //! @brief         Condenses a dim array and step arrays into smaller arrays
-  //!                if able to
-  //! @param[in,out] sizes - dimension array as a point
-  //! @param[in,out] step1 - step array as a point
-  //! @param[in,out] step2 - step array as a point that relates to another
-  //!                NArray, must be aligned and related to the same dimension
-  //!                array
-  //! @return        the dimension of the arrays after condensing, values at or
-  //!                after n in the arrays are junk
-  //!
-  //! Is used when applying operations on arrays to effectively reduce the
-  //! dimensionality of the data which will reduce loops and function calls.
-  //! Condensing the dim and step arrays from an aligned and continuous NArray
-  //! should result in return=1, sizes=size(sizes), step1={1}, step2={1}
-  //! Dimension array should all be positive and non-zero and step arrays must 
-  //! be valid to produce a meaningful result
-  template <std::size_t N>
-  std::size_t condense(Point<N>& sizes, Point<N>& step1, Point<N>& step2) noexcept
-  {
-    std::size_t j = 0;
-    for (std::size_t i = 1; i < N; ++i)
-    {
-      if (sizes[i] * step1[i] == step1[i-1])
-        sizes[j] *= sizes[i];
-      else
-      {
-        step1[j] = step1[i-1];
-        step2[j] = step2[i-1];
-        sizes[++j] = sizes[i];
-      }
-    }
-    step1[j] = step1[N-1];
-    step2[j] = step2[N-1];
-    return j+1;
-  }
-
 } // namespace detail
 
   template <class T>
@@ -799,13 +761,19 @@ namespace detail
 
   }
 
+  template <class T, std::size_t N>
+  NArray<T, N>::~NArray()
+  {
+    WILT_NARRAY_UNTRACK_VIEW(*this);
+  }
+
   template <class T, std::size_t N>
   NArray<T, N>::NArray(const NArray<T, N>& arr) noexcept
     : data_(arr.data_)
     , sizes_(arr.sizes_)
     , steps_(arr.steps_)
   {
-
+    WILT_NARRAY_TRACK_VIEW(*this);
   }
 
   template <class T, std::size_t N>
@@ -815,6 +783,7 @@ namespace detail
     , steps_(arr.steps_)
   {
     arr.clear();
+    WILT_NARRAY_TRACK_VIEW(*this);
   }
 
   template <class T, std::size_t N>
@@ -825,6 +794,8 @@ namespace detail
     , steps_(arr.steps_)
   {
     static_assert(std::is_const<T>::value && std::is_same<U, typename std::remove_const<T>::type>::value, "NArray<const T, N>(const NArray<T, N>&): invalid for any other conversions");
+
+    WILT_NARRAY_TRACK_VIEW(*this);
   }
 
   template <class T, std::size_t N>
@@ -837,34 +808,35 @@ namespace detail
     static_assert(std::is_const<T>::value && std::is_same<U, typename std::remove_const<T>::type>::value, "NArray<const T, N>(NArray<T, N>&&): invalid for any other conversions");
 
     arr.clear();
+    WILT_NARRAY_TRACK_VIEW(*this);
   }
 
   template <class T, std::size_t N>
-  NArray<T, N>::NArray(const Point<N>& size)
+  NArray<T, N>::NArray(const Point<N>& size, NArrayStorageType storage)
     : data_()
     , sizes_()
     , steps_()
   {
-    if (!wilt::detail::validSize(size))
-      throw std::invalid_argument("NArray(size): size is not valid");
+    WILT_NARRAY_CHECK(wilt::detail::validSize(size), std::invalid_argument, "NArray(size): size is not valid");
 
     sizes_ = size;
     steps_ = wilt::detail::step(size);
-    data_ = std::make_shared<wilt::detail::NArrayDataBlock<typename std::remove_const<T>::type>>(wilt::detail::size(size))->data();
+    data_ = wilt::detail::NArrayDataBlock<typename std::remove_const<T>::type>(wilt::detail::size(size), storage).data();
+    WILT_NARRAY_TRACK_VIEW(*this);
   }
 
   template <class T, std::size_t N>
-  NArray<T, N>::NArray(const Point<N>& size, const T& val)
+  NArray<T, N>::NArray(const Point<N>& size, const T& val, NArrayStorageType storage)
     : data_()
     , sizes_()
     , steps_()
   {
-    if (!wilt::detail::validSize(size))
-      throw std::invalid_argument("NArray(size, val): size is not valid");
+    WILT_NARRAY_CHECK(wilt::detail::validSize(size), std::invalid_argument, "NArray(size, val): size is not valid");
 
     sizes_ = size;
     steps_ = wilt::detail::step(size);
-    data_ = std::make_shared<wilt::detail::NArrayDataBlock<typename std::remove_const<T>::type>>(wilt::detail::size(size), val)->data();
+    data_ = wilt::detail::NArrayDataBlock<typename std::remove_const<T>::type>(wilt::detail::size(size), val, storage).data();
+    WILT_NARRAY_TRACK_VIEW(*this);
   }
 
   template <class T, std::size_t N>
@@ -873,12 +845,12 @@ namespace detail
     , sizes_()
     , steps_()
   {
-    if (!wilt::detail::validSize(size))
-      throw std::invalid_argument("NArray(size, ptr, atype): size is not valid");
+    WILT_NARRAY_CHECK(wilt::detail::validSize(size), std::invalid_argument, "NArray(size, ptr, atype): size is not valid");
 
     sizes_ = size;
     steps_ = wilt::detail::step(size);
-    data_ = std::make_shared<wilt::detail::NArrayDataBlock<typename std::remove_const<T>::type>>(wilt::detail::size(size), ptr, atype)->data();
+    data_ = wilt::detail::NArrayDataBlock<typename std::remove_const<T>::type>(wilt::detail::size(size), ptr, atype).data();
+    WILT_NARRAY_TRACK_VIEW(*this);
   }
 
   template <class T, std::size_t N>
@@ -887,12 +859,12 @@ namespace detail
     , sizes_()
     , steps_()
   {
-    if (!wilt::detail::validSize(size))
-      throw std::invalid_argument("NArray(size, list): size is not valid");
+    WILT_NARRAY_CHECK(wilt::detail::validSize(size), std::invalid_argument, "NArray(size, list): size is not valid");
 
     sizes_ = size;
     steps_ = wilt::detail::step(size);
-    data_ = std::make_shared<wilt::detail::NArrayDataBlock<typename std::remove_const<T>::type>>(wilt::detail::size(size), list.begin(), list.end())->data();
+    data_ = wilt::detail::NArrayDataBlock<typename std::remove_const<T>::type>(wilt::detail::size(size), list.begin(), list.end()).data();
+    WILT_NARRAY_TRACK_VIEW(*this);
   }
 
   template <class T, std::size_t N>
@@ -902,12 +874,12 @@ namespace detail
     , sizes_()
     , steps_()
   {
-    if (!wilt::detail::validSize(size))
-      throw std::invalid_argument("NArray(size, gen): size is not valid");
+    WILT_NARRAY_CHECK(wilt::detail::validSize(size), std::invalid_argument, "NArray(size, gen): size is not valid");
 
     sizes_ = size;
     steps_ = wilt::detail::step(size);
-    data_ = std::make_shared<wilt::detail::NArrayDataBlock<typename std::remove_const<T>::type>>(wilt::detail::size(size), gen)->data();
+    data_ = wilt::detail::NArrayDataBlock<typename std::remove_const<T>::type>(wilt::detail::size(size), gen).data();
+    WILT_NARRAY_TRACK_VIEW(*this);
   }
 
   template <class T, std::size_t N>
@@ -917,12 +889,12 @@ namespace detail
     , sizes_()
     , steps_()
   {
-    if (!wilt::detail::validSize(size))
-      throw std::invalid_argument("NArray(size, first, last): size is not valid");
+    WILT_NARRAY_CHECK(wilt::detail::validSize(size), std::invalid_argument, "NArray(size, first, last): size is not valid");
 
     sizes_ = size;
     steps_ = wilt::detail::step(size);
-    data_ = std::make_shared<wilt::detail::NArrayDataBlock<typename std::remove_const<T>::type>>(wilt::detail::size(size), first, last)->data();
+    data_ = wilt::detail::NArrayDataBlock<typename std::remove_const<T>::type>(wilt::detail::size(size), first, last).data();
+    WILT_NARRAY_TRACK_VIEW(*this);
   }
 
   template <class T, std::size_t N>
@@ -931,11 +903,11 @@ namespace detail
     , sizes_()
     , steps_()
   {
-    if (!wilt::detail::validSize(size))
-      throw std::invalid_argument("NArray(data, size): size is not valid");
+    WILT_NARRAY_CHECK(wilt::detail::validSize(size), std::invalid_argument, "NArray(data, size): size is not valid");
 
     sizes_ = size;
     steps_ = wilt::detail::step(size);
+    WILT_NARRAY_TRACK_VIEW(*this);
   }
 
   template <class T, std::size_t N>
@@ -944,7 +916,8 @@ namespace detail
     , sizes_(sizes)
     , steps_(steps)
   {
-
+    WILT_NARRAY_COUNT(VIEWS, 1);
+    WILT_NARRAY_TRACK_VIEW(*this);
   }
 
   template <class T, std::size_t N>
@@ -954,6 +927,8 @@ namespace detail
     sizes_ = arr.sizes_;
     steps_ = arr.steps_;
 
+    WILT_NARRAY_TRACK_VIEW(*this);
+
     return *this;
   }
 
@@ -966,6 +941,8 @@ namespace detail
 
     arr.clear();
 
+    WILT_NARRAY_TRACK_VIEW(*this);
+
     return *this;
   }
 
@@ -979,6 +956,8 @@ namespace detail
     sizes_ = arr.sizes_;
     steps_ = arr.steps_;
 
+    WILT_NARRAY_TRACK_VIEW(*this);
+
     return *this;
   }
 
@@ -994,16 +973,18 @@ namespace detail
 
     arr.clear();
 
+    WILT_NARRAY_TRACK_VIEW(*this);
+
     return *this;
   }
 
   template <class T, std::size_t N>
   NArray<T, N>& NArray<T, N>::operator+= (const NArray<const T, N>& arr)
   {
+    WILT_NARRAY_TRACE_SCOPE("operator+=", *this);
     static_assert(!std::is_const<T>::value, "operator+=(arr): invalid on const type");
 
-    if (sizes_ != arr.sizes_)
-      throw std::invalid_argument("operator+=(arr): dimensions must match");
+    WILT_NARRAY_CHECK(sizes_ == arr.sizes_, std::invalid_argument, "operator+=(arr): dimensions must match");
     if (empty())
       return *this;
 
@@ -1018,6 +999,7 @@ namespace detail
   template <class T, std::size_t N>
   NArray<T, N>& NArray<T, N>::operator+= (const T& val)
   {
+    WILT_NARRAY_TRACE_SCOPE("operator+=", *this);
     static_assert(!std::is_const<T>::value, "operator+=(val): invalid on const type");
 
     if (empty())
@@ -1031,10 +1013,10 @@ namespace detail
   template <class T, std::size_t N>
   NArray<T, N>& NArray<T, N>::operator-= (const NArray<const T, N>& arr)
   {
+    WILT_NARRAY_TRACE_SCOPE("operator-=", *this);
     static_assert(!std::is_const<T>::value, "operator-=(arr): invalid on const type");
 
-    if (sizes_ != arr.sizes_)
-      throw std::invalid_argument("operator-=(arr): dimensions must match");
+    WILT_NARRAY_CHECK(sizes_ == arr.sizes_, std::invalid_argument, "operator-=(arr): dimensions must match");
     if (empty())
       return *this;
 
@@ -1049,6 +1031,7 @@ namespace detail
   template <class T, std::size_t N>
   NArray<T, N>& NArray<T, N>::operator-= (const T& val)
   {
+    WILT_NARRAY_TRACE_SCOPE("operator-=", *this);
     static_assert(!std::is_const<T>::value, "operator-=(val): invalid on const type");
 
     if (empty())
@@ -1062,6 +1045,7 @@ namespace detail
   template <class T, std::size_t N>
   NArray<T, N>& NArray<T, N>::operator*= (const T& val)
   {
+    WILT_NARRAY_TRACE_SCOPE("operator*=", *this);
     static_assert(!std::is_const<T>::value, "operator*=(val): invalid on const type");
 
     if (empty())
@@ -1075,6 +1059,7 @@ namespace detail
   template <class T, std::size_t N>
   NArray<T, N>& NArray<T, N>::operator/= (const T& val)
   {
+    WILT_NARRAY_TRACE_SCOPE("operator/=", *this);
     static_assert(!std::is_const<T>::value, "operator/=(val): invalid on const type");
 
     if (empty())
@@ -1100,8 +1085,7 @@ namespace detail
   template <class T, std::size_t N>
   std::size_t NArray<T, N>::size(std::size_t dim) const
   {
-    if (dim >= N)
-      throw std::out_of_range("size(dim): dim out of bounds");
+    WILT_NARRAY_CHECK(dim < N, std::out_of_range, "size(dim): dim out of bounds");
 
     return (std::size_t)sizes_[dim];
   }
@@ -1137,8 +1121,7 @@ namespace detail
   template <class T, std::size_t N>
   pos_t NArray<T, N>::step(std::size_t dim) const
   {
-    if (dim >= N)
-      throw std::out_of_range("step(dim): dim out of bounds");
+    WILT_NARRAY_CHECK(dim < N, std::out_of_range, "step(dim): dim out of bounds");
 
     return steps_[dim];
   }
@@ -1164,11 +1147,14 @@ namespace detail
   template <class T, std::size_t N>
   bool NArray<T, N>::isContiguous() const noexcept
   {
+    if (isRepeated())
+      return false;
+
     pos_t stepSize = 0;
     for (std::size_t i = 0; i < N; ++i)
       stepSize += steps_[i] * (sizes_[i] - 1);
 
-    return stepSize + 1 == this->size();
+    return stepSize + 1 == (pos_t)this->size();
   }
 
   template <class T, std::size_t N>
@@ -1188,15 +1174,23 @@ namespace detail
     return true;
   }
 
+  template <class T, std::size_t N>
+  bool NArray<T, N>::isRepeated() const noexcept
+  {
+    for (std::size_t i = 0; i < N; ++i)
+      if (steps_[i] == 0 && sizes_[i] > 1)
+        return true;
+
+    return false;
+  }
+
   template <class T, std::size_t N>
   typename NArray<T, N>::reference NArray<T, N>::at(const Point<N>& loc) const
   {
-    if (empty())
-      throw std::runtime_error("at(): invalid when empty");
+    WILT_NARRAY_CHECK(!empty(), std::runtime_error, "at(): invalid when empty");
 
     for (std::size_t i = 0; i < N; ++i)
-      if (loc[i] >= sizes_[i] || loc[i] < 0)
-        throw std::out_of_range("at(loc): element larger then dimensions");
+      WILT_NARRAY_CHECK(loc[i] < sizes_[i] && loc[i] >= 0, std::out_of_range, "at(loc): element larger then dimensions");
 
     return atUnchecked(loc);
   }
@@ -1275,6 +1269,7 @@ namespace detail
   template <class Operator>
   void NArray<T, N>::foreach(Operator op) const
   {
+    WILT_NARRAY_TRACE_SCOPE("foreach", *this);
     wilt::detail::unary<N>(sizes_.data(), data_.get(), steps_.data(), op);
   }
 
@@ -1287,30 +1282,26 @@ namespace detail
   template <class T, std::size_t N>
   typename NArray<T, N-1>::exposed_type NArray<T, N>::operator[] (pos_t n) const
   {
-    if (n < 0 || n >= sizes_[0])
-      throw std::out_of_range("operator[](): n out of bounds");
+    WILT_NARRAY_CHECK(n >= 0 && n < sizes_[0], std::out_of_range, "operator[](): n out of bounds");
 
-    return slice_(0, n);
+    return sliceUnchecked(0, n);
   }
 
   template <class T, std::size_t N>
   typename NArray<T, N-1>::exposed_type NArray<T, N>::slice(std::size_t dim, pos_t n) const
   {
-    if (dim >= N)
-      throw std::out_of_range("slice(dim, n): dim out of bounds");
-    if (n >= sizes_[dim] || n < 0)
-      throw std::out_of_range("slice(dim, n): n out of bounds");
+    WILT_NARRAY_CHECK(dim < N, std::out_of_range, "slice(dim, n): dim out of bounds");
+    WILT_NARRAY_CHECK(n < sizes_[dim] && n >= 0, std::out_of_range, "slice(dim, n): n out of bounds");
 
-    return slice_(dim, n);
+    return sliceUnchecked(dim, n);
   }
 
   template <class T, std::size_t N>
   typename NArray<T, N-1>::exposed_type NArray<T, N>::sliceX(pos_t x) const
   {
-    if (x >= sizes_[0] || x < 0)
-      throw std::out_of_range("sliceX(x): x out of bounds");
+    WILT_NARRAY_CHECK(x < sizes_[0] && x >= 0, std::out_of_range, "sliceX(x): x out of bounds");
 
-    return slice_(0, x);
+    return sliceUnchecked(0, x);
   }
 
   template <class T, std::size_t N>
@@ -1318,10 +1309,9 @@ namespace detail
   {
     static_assert(N >= 2, "sliceY(y): invalid when N < 2");
 
-    if (y >= sizes_[1] || y < 0)
-      throw std::out_of_range("sliceY(y): y out of bounds");
+    WILT_NARRAY_CHECK(y < sizes_[1] && y >= 0, std::out_of_range, "sliceY(y): y out of bounds");
 
-    return slice_(1, y);
+    return sliceUnchecked(1, y);
   }
 
   template <class T, std::size_t N>
@@ -1329,10 +1319,9 @@ namespace detail
   {
     static_assert(N >= 3, "sliceZ(z): invalid when N < 3");
 
-    if (z >= sizes_[2] || z < 0)
-      throw std::out_of_range("sliceZ(z): z out of bounds");
+    WILT_NARRAY_CHECK(z < sizes_[2] && z >= 0, std::out_of_range, "sliceZ(z): z out of bounds");
 
-    return slice_(2, z);
+    return sliceUnchecked(2, z);
   }
 
   template <class T, std::size_t N>
@@ -1340,14 +1329,13 @@ namespace detail
   {
     static_assert(N >= 4, "sliceW(w): invalid when N < 4");
 
-    if (w >= sizes_[3] || w < 0)
-      throw std::out_of_range("sliceW(w): w out of bounds");
+    WILT_NARRAY_CHECK(w < sizes_[3] && w >= 0, std::out_of_range, "sliceW(w): w out of bounds");
 
-    return slice_(3, w);
+    return sliceUnchecked(3, w);
   }
 
   template <class T, std::size_t N>
-  typename NArray<T, N-1>::exposed_type NArray<T, N>::slice_(std::size_t dim, pos_t n) const noexcept
+  typename NArray<T, N-1>::exposed_type NArray<T, N>::sliceUnchecked(std::size_t dim, pos_t n) const noexcept
   {
     auto newdata = data_.get() + steps_[dim] * n;
     auto newsizes = sizes_.removed(dim);
@@ -1359,25 +1347,20 @@ namespace detail
   template <class T, std::size_t N>
   NArray<T, N> NArray<T, N>::range(std::size_t dim, pos_t start, pos_t length) const
   {
-    if (dim >= N)
-      throw std::out_of_range("range(dim, start, length): dim out of bounds");
-    if (start < 0 || start >= sizes_[dim])
-      throw std::out_of_range("range(dim, start, length): start out of bounds");
-    if (length <= 0 || start + length > sizes_[dim])
-      throw std::out_of_range("range(dim, start, length): length out of bounds");
+    WILT_NARRAY_CHECK(dim < N, std::out_of_range, "range(dim, start, length): dim out of bounds");
+    WILT_NARRAY_CHECK(start >= 0 && start < sizes_[dim], std::out_of_range, "range(dim, start, length): start out of bounds");
+    WILT_NARRAY_CHECK(length > 0 && start + length <= sizes_[dim], std::out_of_range, "range(dim, start, length): length out of bounds");
 
-    return range_(dim, start, length);
+    return rangeUnchecked(dim, start, length);
   }
 
   template <class T, std::size_t N>
   NArray<T, N> NArray<T, N>::rangeX(pos_t start, pos_t length) const
   {
-    if (start < 0 || start >= sizes_[0])
-      throw std::out_of_range("rangeX(start, length): start out of bounds");
-    if (length <= 0 || start + length > sizes_[0])
-      throw std::out_of_range("rangeX(start, length): length out of bounds");
+    WILT_NARRAY_CHECK(start >= 0 && start < sizes_[0], std::out_of_range, "rangeX(start, length): start out of bounds");
+    WILT_NARRAY_CHECK(length > 0 && start + length <= sizes_[0], std::out_of_range, "rangeX(start, length): length out of bounds");
 
-    return range_(0, start, length);
+    return rangeUnchecked(0, start, length);
   }
 
   template <class T, std::size_t N>
@@ -1385,12 +1368,10 @@ namespace detail
   {
     static_assert(N >= 2, "rangeY(start, length): invalid when N < 2");
 
-    if (start < 0 || start >= sizes_[1])
-      throw std::out_of_range("rangeY(start, length): start out of bounds");
-    if (length <= 0 || start + length > sizes_[1])
-      throw std::out_of_range("rangeY(start, length): length out of bounds");
+    WILT_NARRAY_CHECK(start >= 0 && start < sizes_[1], std::out_of_range, "rangeY(start, length): start out of bounds");
+    WILT_NARRAY_CHECK(length > 0 && start + length <= sizes_[1], std::out_of_range, "rangeY(start, length): length out of bounds");
 
-    return range_(1, start, length);
+    return rangeUnchecked(1, start, length);
   }
 
   template <class T, std::size_t N>
@@ -1398,12 +1379,10 @@ namespace detail
   {
     static_assert(N >= 3, "rangeZ(start, length): invalid when N < 3");
 
-    if (start < 0 || start >= sizes_[2])
-      throw std::out_of_range("rangeZ(start, length): start out of bounds");
-    if (length <= 0 || start + length > sizes_[2])
-      throw std::out_of_range("rangeZ(start, length): length out of bounds");
+    WILT_NARRAY_CHECK(start >= 0 && start < sizes_[2], std::out_of_range, "rangeZ(start, length): start out of bounds");
+    WILT_NARRAY_CHECK(length > 0 && start + length <= sizes_[2], std::out_of_range, "rangeZ(start, length): length out of bounds");
 
-    return range_(2, start, length);
+    return rangeUnchecked(2, start, length);
   }
 
   template <class T, std::size_t N>
@@ -1411,16 +1390,14 @@ namespace detail
   {
     static_assert(N >= 4, "rangeW(start, length): invalid when N < 4");
 
-    if (start < 0 || start >= sizes_[3])
-      throw std::out_of_range("rangeW(start, length): start out of bounds");
-    if (length <= 0 || start + length > sizes_[3])
-      throw std::out_of_range("rangeW(start, length): length out of bounds");
+    WILT_NARRAY_CHECK(start >= 0 && start < sizes_[3], std::out_of_range, "rangeW(start, length): start out of bounds");
+    WILT_NARRAY_CHECK(length > 0 && start + length <= sizes_[3], std::out_of_range, "rangeW(start, length): length out of bounds");
 
-    return range_(3, start, length);
+    return rangeUnchecked(3, start, length);
   }
 
   template <class T, std::size_t N>
-  NArray<T, N> NArray<T, N>::range_(std::size_t dim, pos_t start, pos_t length) const noexcept
+  NArray<T, N> NArray<T, N>::rangeUnchecked(std::size_t dim, pos_t start, pos_t length) const noexcept
   {
     auto newdata = data_.get() + steps_[dim] * start;
     auto newsizes = sizes_;
@@ -1432,16 +1409,15 @@ namespace detail
   template <class T, std::size_t N>
   NArray<T, N> NArray<T, N>::flip(std::size_t dim) const
   {
-    if (dim >= N)
-      throw std::out_of_range("flip(dim): dim out of bounds");
+    WILT_NARRAY_CHECK(dim < N, std::out_of_range, "flip(dim): dim out of bounds");
 
-    return flip_(dim);
+    return flipUnchecked(dim);
   }
 
   template <class T, std::size_t N>
   NArray<T, N> NArray<T, N>::flipX() const
   {
-    return flip_(0);
+    return flipUnchecked(0);
   }
 
   template <class T, std::size_t N>
@@ -1449,7 +1425,7 @@ namespace detail
   {
     static_assert(N >= 2, "flipY(): invalid when N < 2");
 
-    return flip_(1);
+    return flipUnchecked(1);
   }
 
   template <class T, std::size_t N>
@@ -1457,7 +1433,7 @@ namespace detail
   {
     static_assert(N >= 3, "flipZ(): invalid when N < 3");
 
-    return flip_(2);
+    return flipUnchecked(2);
   }
 
   template <class T, std::size_t N>
@@ -1465,11 +1441,11 @@ namespace detail
   {
     static_assert(N >= 4, "flipW(): invalid when N < 4");
 
-    return flip_(3);
+    return flipUnchecked(3);
   }
 
   template <class T, std::size_t N>
-  NArray<T, N> NArray<T, N>::flip_(std::size_t dim) const noexcept
+  NArray<T, N> NArray<T, N>::flipUnchecked(std::size_t dim) const noexcept
   {
     auto newdata = data_.get() + steps_[dim] * (sizes_[dim] - 1);
     auto newsteps = steps_;
@@ -1481,25 +1457,20 @@ namespace detail
   template <class T, std::size_t N>
   NArray<T, N> NArray<T, N>::skip(std::size_t dim, pos_t n, pos_t start) const
   {
-    if (dim >= N)
-      throw std::out_of_range("skip(dim, n, start): dim out of bounds");
-    if (n < 1 || n >= sizes_[dim])
-      throw std::out_of_range("skip(dim, n, start): n out of bounds");
-    if (start < 0 || start >= sizes_[dim])
-      throw std::out_of_range("skip(dim, n, start): start out of bounds");
+    WILT_NARRAY_CHECK(dim < N, std::out_of_range, "skip(dim, n, start): dim out of bounds");
+    WILT_NARRAY_CHECK(n >= 1 && n < sizes_[dim], std::out_of_range, "skip(dim, n, start): n out of bounds");
+    WILT_NARRAY_CHECK(start >= 0 && start < sizes_[dim], std::out_of_range, "skip(dim, n, start): start out of bounds");
 
-    return skip_(dim, n, start);
+    return skipUnchecked(dim, n, start);
   }
 
   template <class T, std::size_t N>
   NArray<T, N> NArray<T, N>::skipX(pos_t n, pos_t start) const
   {
-    if (n < 1 || n >= sizes_[0])
-      throw std::out_of_range("skipX(n, start): n out of bounds");
-    if (start < 0 || start >= sizes_[0])
-      throw std::out_of_range("skipX(n, start): start out of bounds");
+    WILT_NARRAY_CHECK(n >= 1 && n < sizes_[0], std::out_of_range, "skipX(n, start): n out of bounds");
+    WILT_NARRAY_CHECK(start >= 0 && start < sizes_[0], std::out_of_range, "skipX(n, start): start out of bounds");
 
-    return skip_(0, n, start);
+    return skipUnchecked(0, n, start);
   }
 
   template <class T, std::size_t N>
@@ -1507,12 +1478,10 @@ namespace detail
   {
     static_assert(N >= 2, "skipY(n, start): invalid when N < 2");
 
-    if (n < 1 || n >= sizes_[1])
-      throw std::out_of_range("skipY(n, start): n out of bounds");
-    if (start < 0 || start >= sizes_[1])
-      throw std::out_of_range("skipY(n, start): start out of bounds");
+    WILT_NARRAY_CHECK(n >= 1 && n < sizes_[1], std::out_of_range, "skipY(n, start): n out of bounds");
+    WILT_NARRAY_CHECK(start >= 0 && start < sizes_[1], std::out_of_range, "skipY(n, start): start out of bounds");
 
-    return skip_(1, n, start);
+    return skipUnchecked(1, n, start);
   }
 
   template <class T, std::size_t N>
@@ -1520,12 +1489,10 @@ namespace detail
   {
     static_assert(N >= 3, "skipZ(n, start): invalid when N < 3");
 
-    if (n < 1 || n >= sizes_[2])
-      throw std::out_of_range("skipZ(n, start): n out of bounds");
-    if (start < 0 || start >= sizes_[2])
-      throw std::out_of_range("skipZ(n, start): start out of bounds");
+    WILT_NARRAY_CHECK(n >= 1 && n < sizes_[2], std::out_of_range, "skipZ(n, start): n out of bounds");
+    WILT_NARRAY_CHECK(start >= 0 && start < sizes_[2], std::out_of_range, "skipZ(n, start): start out of bounds");
 
-    return skip_(2, n, start);
+    return skipUnchecked(2, n, start);
   }
 
   template <class T, std::size_t N>
@@ -1533,16 +1500,14 @@ namespace detail
   {
     static_assert(N >= 4, "skipW(n, start): invalid when N < 4");
 
-    if (n < 1 || n >= sizes_[3])
-      throw std::out_of_range("skipW(n, start): n out of bounds");
-    if (start < 0 || start >= sizes_[3])
-      throw std::out_of_range("skipW(n, start): start out of bounds");
+    WILT_NARRAY_CHECK(n >= 1 && n < sizes_[3], std::out_of_range, "skipW(n, start): n out of bounds");
+    WILT_NARRAY_CHECK(start >= 0 && start < sizes_[3], std::out_of_range, "skipW(n, start): start out of bounds");
 
-    return skip_(3, n, start);
+    return skipUnchecked(3, n, start);
   }
 
   template <class T, std::size_t N>
-  NArray<T, N> NArray<T, N>::skip_(std::size_t dim, pos_t n, pos_t start) const noexcept
+  NArray<T, N> NArray<T, N>::skipUnchecked(std::size_t dim, pos_t n, pos_t start) const noexcept
   {
     auto newdata = data_.get() + steps_[dim] * start;
     auto newsizes = sizes_;
@@ -1564,11 +1529,15 @@ namespace detail
   template <class T, std::size_t N>
   NArray<T, N> NArray<T, N>::transpose(std::size_t dim1, std::size_t dim2) const
   {
-    if (dim1 >= N)
-      throw std::out_of_range("transpose(dim1, dim2): dim1 out of bounds");
-    if (dim2 >= N)
-      throw std::out_of_range("transpose(dim1, dim2): dim2 out of bounds");
+    WILT_NARRAY_CHECK(dim1 < N, std::out_of_range, "transpose(dim1, dim2): dim1 out of bounds");
+    WILT_NARRAY_CHECK(dim2 < N, std::out_of_range, "transpose(dim1, dim2): dim2 out of bounds");
 
+    return transposeUnchecked(dim1, dim2);
+  }
+
+  template <class T, std::size_t N>
+  NArray<T, N> NArray<T, N>::transposeUnchecked(std::size_t dim1, std::size_t dim2) const noexcept
+  {
     auto newsizes = sizes_.swapped(dim1, dim2);
     auto newsteps = steps_.swapped(dim1, dim2);
 
@@ -1577,14 +1546,19 @@ namespace detail
 
   template <class T, std::size_t N>
   NArray<T, N> NArray<T, N>::subarray(const Point<N>& loc, const Point<N>& size) const
+  {
+    for (std::size_t i = 0; i < N; ++i)
+      WILT_NARRAY_CHECK(size[i] + loc[i] <= sizes_[i] && size[i] > 0 && loc[i] >= 0 && loc[i] < sizes_[i], std::out_of_range, "subarray(loc, size): index out of bounds");
+
+    return subarrayUnchecked(loc, size);
+  }
+
+  template <class T, std::size_t N>
+  NArray<T, N> NArray<T, N>::subarrayUnchecked(const Point<N>& loc, const Point<N>& size) const noexcept
   {
     T* newdata = data_.get();
     for (std::size_t i = 0; i < N; ++i)
-    {
-      if (size[i] + loc[i] > sizes_[i] || size[i] <= 0 || loc[i] < 0 || loc[i] >= sizes_[i])
-        throw std::out_of_range("subarray(loc, size): index out of bounds");
       newdata += steps_[i] * loc[i];
-    }
 
     return NArray<T, N>(std::shared_ptr<T>(data_, newdata), size, steps_);
   }
@@ -1593,12 +1567,10 @@ namespace detail
   template <std::size_t M>
   typename NArray<T, N-M>::exposed_type NArray<T, N>::subarrayAt(const Point<M>& pos) const
   {
-    if (empty())
-      throw std::runtime_error("subarrayAt(pos): invalid when empty");
+    WILT_NARRAY_CHECK(!empty(), std::runtime_error, "subarrayAt(pos): invalid when empty");
 
     for (std::size_t i = 0; i < M; ++i)
-      if (pos[i] >= sizes_[i] || pos[i] < 0)
-        throw std::out_of_range("subarrayAt(pos): pos out of range");
+      WILT_NARRAY_CHECK(pos[i] < sizes_[i] && pos[i] >= 0, std::out_of_range, "subarrayAt(pos): pos out of range");
 
     return subarrayAtUnchecked(pos);
   }
@@ -1635,10 +1607,8 @@ namespace detail
   template <std::size_t M>
   NArray<T, M> NArray<T, N>::reshape(const Point<M>& size) const
   {
-    if (empty())
-      throw std::domain_error("reshape(size): this is empty");
-    if (!wilt::detail::validSize(size))
-      throw std::invalid_argument("reshape(size): size dimensions must all be positive");
+    WILT_NARRAY_CHECK(!empty(), std::domain_error, "reshape(size): this is empty");
+    WILT_NARRAY_CHECK(wilt::detail::validSize(size), std::invalid_argument, "reshape(size): size dimensions must all be positive");
 
     Point<N> oldsizes = sizes_;
     Point<N> oldsteps = steps_;
@@ -1681,11 +1651,15 @@ namespace detail
   template<class T, std::size_t N>
   NArray<T, N+1> NArray<T, N>::repeat(pos_t n) const
   {
-    if (empty())
-      throw std::domain_error("repeat(n): this is empty");
-    if (n <= 0)
-      throw std::invalid_argument("repeat(n): n must be positive");
+    WILT_NARRAY_CHECK(!empty(), std::domain_error, "repeat(n): this is empty");
+    WILT_NARRAY_CHECK(n > 0, std::invalid_argument, "repeat(n): n must be positive");
 
+    return repeatUnchecked(n);
+  }
+
+  template<class T, std::size_t N>
+  NArray<T, N+1> NArray<T, N>::repeatUnchecked(pos_t n) const noexcept
+  {
     auto newsizes = sizes_.inserted(N, n);
     auto newsteps = steps_.inserted(N, 0);
 
@@ -1695,21 +1669,18 @@ namespace detail
   template<class T, std::size_t N>
   NArray<T, N+1> NArray<T, N>::window(std::size_t dim, pos_t n) const
   {
-    if (dim >= N)
-      throw std::out_of_range("window(n, dim): dim out of bounds");
-    if (n < 1 || n > sizes_[dim])
-      throw std::out_of_range("window(n, dim): n out of bounds");
+    WILT_NARRAY_CHECK(dim < N, std::out_of_range, "window(n, dim): dim out of bounds");
+    WILT_NARRAY_CHECK(n >= 1 && n <= sizes_[dim], std::out_of_range, "window(n, dim): n out of bounds");
 
-    return window_(dim, n);
+    return windowUnchecked(dim, n);
   }
 
   template<class T, std::size_t N>
   NArray<T, N+1> NArray<T, N>::windowX(pos_t n) const
   {
-    if (n < 1 || n > sizes_[0])
-      throw std::out_of_range("windowX(n): n out of bounds");
+    WILT_NARRAY_CHECK(n >= 1 && n <= sizes_[0], std::out_of_range, "windowX(n): n out of bounds");
 
-    return window_(0, n);
+    return windowUnchecked(0, n);
   }
 
   template<class T, std::size_t N>
@@ -1717,10 +1688,9 @@ namespace detail
   {
     static_assert(N >= 2, "windowY(n): invalid when N < 2");
 
-    if (n < 1 || n > sizes_[1])
-      throw std::out_of_range("windowY(n): n out of bounds");
+    WILT_NARRAY_CHECK(n >= 1 && n <= sizes_[1], std::out_of_range, "windowY(n): n out of bounds");
 
-    return window_(1, n);
+    return windowUnchecked(1, n);
   }
 
   template<class T, std::size_t N>
@@ -1728,10 +1698,9 @@ namespace detail
   {
     static_assert(N >= 3, "windowZ(n): invalid when N < 3");
 
-    if (n < 1 || n > sizes_[2])
-      throw std::out_of_range("windowZ(n): n out of bounds");
+    WILT_NARRAY_CHECK(n >= 1 && n <= sizes_[2], std::out_of_range, "windowZ(n): n out of bounds");
 
-    return window_(2, n);
+    return windowUnchecked(2, n);
   }
 
   template<class T, std::size_t N>
@@ -1739,14 +1708,13 @@ namespace detail
   {
     static_assert(N >= 4, "windowW(n): invalid when N < 4");
 
-    if (n < 1 || n > sizes_[3])
-      throw std::out_of_range("windowW(n): n out of bounds");
+    WILT_NARRAY_CHECK(n >= 1 && n <= sizes_[3], std::out_of_range, "windowW(n): n out of bounds");
 
-    return window_(3, n);
+    return windowUnchecked(3, n);
   }
 
   template<class T, std::size_t N>
-  NArray<T, N+1> NArray<T, N>::window_(std::size_t dim, pos_t n) const noexcept
+  NArray<T, N+1> NArray<T, N>::windowUnchecked(std::size_t dim, pos_t n) const noexcept
   {
     auto newsizes = sizes_.inserted(N, n);
     auto newsteps = steps_.inserted(N, steps_[dim]);
@@ -1806,16 +1774,37 @@ namespace detail
   template <class T, std::size_t N>
   NArray<typename std::remove_const<T>::type, N> NArray<T, N>::clone() const
   {
+    WILT_NARRAY_TRACE_SCOPE("clone", *this);
     if (empty())
       return NArray<typename std::remove_const<T>::type, N>();
 
+    WILT_NARRAY_COUNT(CLONES, 1);
+    WILT_NARRAY_COUNT(CLONED_BYTES, size() * sizeof(T));
+
     return NArray<typename std::remove_const<T>::type, N>(sizes_, [iter = this->begin()]() mutable -> T& { return *iter++; });
   }
 
+  template <class T, std::size_t N>
+  NArray<T, N> NArray<T, N>::compacted(double threshold) const
+  {
+    WILT_NARRAY_CHECK(threshold >= 0.0 && threshold <= 1.0, std::invalid_argument, "compacted(threshold): threshold must be between 0 and 1");
+
+    const std::size_t capacity = wilt::detail::blockBytes(data_);
+    if (empty() || capacity == 0)
+      return *this;
+
+    auto extent = wilt::detail::viewExtent(data_.get(), sizes_, steps_, sizeof(T));
+    if ((double)(extent.second - extent.first) < threshold * (double)capacity)
+      return clone();
+
+    return *this;
+  }
+
   template <class T, std::size_t N>
   template <class U>
   NArray<U, N> NArray<T, N>::convertTo() const
   {
+    WILT_NARRAY_TRACE_SCOPE("convertTo", *this);
     NArray<U, N> ret(sizes_);
     convertTo_(*this, ret, [](const T& t) {return static_cast<U>(t); });
     return ret;
@@ -1825,6 +1814,7 @@ namespace detail
   template <class U, class Converter>
   NArray<U, N> NArray<T, N>::convertTo(Converter func) const
   {
+    WILT_NARRAY_TRACE_SCOPE("convertTo", *this);
     NArray<U, N> ret(sizes_);
     convertTo_(*this, ret, func);
     return ret;
@@ -1834,6 +1824,7 @@ namespace detail
   template<std::size_t M, class Compressor>
   NArray<T, M> NArray<T, N>::compress(Compressor func) const
   {
+    WILT_NARRAY_TRACE_SCOPE("compress", *this);
     static_assert(M <= N, "compress(func): invalid when M > N");
     static_assert(M != 0, "compress(func): invalid when M is zero");
 
@@ -1853,23 +1844,19 @@ namespace detail
   template <class U, class Converter>
   void NArray<T, N>::convertTo_(const wilt::NArray<T, N>& lhs, wilt::NArray<U, N>& rhs, Converter func)
   {
-    Point<N> sizes = lhs.sizes();
-    Point<N> step1 = lhs.steps();
-    Point<N> step2 = rhs.steps();
-    wilt::detail::condense(sizes, step1, step2);
-    wilt::detail::binary<N>(sizes.data(), 
-      rhs.data(), step2.data(), 
-      lhs.data(), step1.data(), 
+    wilt::detail::binary<N>(lhs.sizes().data(), 
+      rhs.data(), rhs.steps().data(), 
+      static_cast<const T*>(lhs.data()), lhs.steps().data(), 
       [&func](U& u, const T& v) { u = func(v); });
   }
 
   template <class T, std::size_t N>
   void NArray<T, N>::setTo(const NArray<const T, N>& arr) const
   {
+    WILT_NARRAY_TRACE_SCOPE("setTo", *this);
     static_assert(!std::is_const<T>::value, "setTo(arr): invalid when element type is const");
 
-    if (sizes_ != arr.sizes())
-      throw std::invalid_argument("setTo(arr): dimensions must match");
+    WILT_NARRAY_CHECK(sizes_ == arr.sizes(), std::invalid_argument, "setTo(arr): dimensions must match");
 
     wilt::detail::binary<N>(sizes_.data(), 
           data_.get(),     steps_.data(), 
@@ -1880,6 +1867,7 @@ namespace detail
   template <class T, std::size_t N>
   void NArray<T, N>::setTo(const T& val) const
   {
+    WILT_NARRAY_TRACE_SCOPE("setTo", *this);
     static_assert(!std::is_const<T>::value, "setTo(val): invalid when element type is const");
 
     wilt::detail::unary<N>(sizes_.data(), data_.get(), steps_.data(), [&val](T& r) { r = val; });
@@ -1888,10 +1876,10 @@ namespace detail
   template <class T, std::size_t N>
   void NArray<T, N>::setTo(const NArray<const T, N>& arr, const NArray<const bool, N>& mask) const
   {
+    WILT_NARRAY_TRACE_SCOPE("setTo", *this);
     static_assert(!std::is_const<T>::value, "setTo(arr, mask): invalid when element type is const");
 
-    if (sizes_ != arr.sizes() || sizes_ != mask.sizes())
-      throw std::invalid_argument("setTo(arr, mask): dimensions must match");
+    WILT_NARRAY_CHECK(sizes_ == arr.sizes() && sizes_ == mask.sizes(), std::invalid_argument, "setTo(arr, mask): dimensions must match");
 
     wilt::detail::ternary<N>(sizes_.data(), 
            data_.get(),      steps_.data(), 
@@ -1903,6 +1891,7 @@ namespace detail
   template <class T, std::size_t N>
   void NArray<T, N>::setTo(const T& val, const NArray<const bool, N>& mask) const
   {
+    WILT_NARRAY_TRACE_SCOPE("setTo", *this);
     static_assert(!std::is_const<T>::value, "setTo(val, mask): invalid when element type is const");
 
     wilt::detail::binary<N>(sizes_.data(), 
@@ -1911,17 +1900,80 @@ namespace detail
       [&val](T& r, bool m) { if (m != 0) r = val; });
   }
 
+  template <class T, std::size_t N>
+  void NArray<T, N>::setTo(const NArray<const T, N>& arr, const BitMask<N>& mask) const
+  {
+    WILT_NARRAY_TRACE_SCOPE("setTo", *this);
+    static_assert(!std::is_const<T>::value, "setTo(arr, mask): invalid when element type is const");
+
+    WILT_NARRAY_CHECK(sizes_ == arr.sizes() && sizes_ == mask.sizes(), std::invalid_argument, "setTo(arr, mask): dimensions must match");
+
+    if (empty())
+      return;
+
+    // the arrays are walked in runs along the last dimension so the mask's
+    // bits can be walked directly, skipping clear words
+    Point<N> sizes = sizes_;
+    Point<N> dststeps = steps_;
+    Point<N> srcsteps = arr.steps_;
+    wilt::detail::condense(sizes, dststeps, srcsteps);
+
+    const pos_t length = sizes[N-1];
+    const pos_t rows = (pos_t)size() / length;
+    const auto outersizes = sizes.removed(N-1);
+    const auto outerdststeps = dststeps.removed(N-1);
+    const auto outersrcsteps = srcsteps.removed(N-1);
+    for (pos_t r = 0; r < rows; ++r)
+    {
+      T* dst = data_.get() + wilt::detail::offsetOf(r, outersizes, outerdststeps);
+      const T* src = arr.data_.get() + wilt::detail::offsetOf(r, outersizes, outersrcsteps);
+      const pos_t first = r * length;
+      mask.forEachSet(first, first + length, [&](pos_t n) {
+        dst[(n - first) * dststeps[N-1]] = src[(n - first) * srcsteps[N-1]];
+      });
+    }
+  }
+
+  template <class T, std::size_t N>
+  void NArray<T, N>::setTo(const T& val, const BitMask<N>& mask) const
+  {
+    WILT_NARRAY_TRACE_SCOPE("setTo", *this);
+    static_assert(!std::is_const<T>::value, "setTo(val, mask): invalid when element type is const");
+
+    WILT_NARRAY_CHECK(sizes_ == mask.sizes(), std::invalid_argument, "setTo(val, mask): dimensions must match");
+    if (empty())
+      return;
+
+    Point<N> sizes = sizes_;
+    Point<N> steps = steps_;
+    wilt::detail::condense(sizes, steps);
+
+    const pos_t length = sizes[N-1];
+    const pos_t rows = (pos_t)size() / length;
+    const auto outersizes = sizes.removed(N-1);
+    const auto outersteps = steps.removed(N-1);
+    for (pos_t r = 0; r < rows; ++r)
+    {
+      T* dst = data_.get() + wilt::detail::offsetOf(r, outersizes, outersteps);
+      const pos_t first = r * length;
+      mask.forEachSet(first, first + length, [&](pos_t n) { dst[(n - first) * steps[N-1]] = val; });
+    }
+  }
+
   template <class T, std::size_t N>
   void NArray<T, N>::clear() noexcept
   {
     data_.reset();
     sizes_.clear();
     steps_.clear();
+
+    WILT_NARRAY_UNTRACK_VIEW(*this);
   }
 
 } // namespace wilt
 
 #include "narrayiterator.hpp"
 #include "operators.hpp"
+#include "bitmask.hpp"
 
 #endif // !WILT_NARRAY_HPP
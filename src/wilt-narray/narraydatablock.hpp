@@ -28,10 +28,24 @@
 #ifndef WILT_NARRAYDATABLOCK_HPP
 #define WILT_NARRAYDATABLOCK_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
 #include <memory>
+#include <new>
 #include <cstddef>
 #include <type_traits>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "memory.hpp"
+#include "parallel.hpp"
+#include "stats.hpp"
+
 namespace wilt
 {
   enum NArrayDataAcquireType
@@ -41,10 +55,199 @@ namespace wilt
     REFERENCE
   };
 
+  // Determines how the first writes to a newly allocated array are split
+  // across threads, which it only has an effect on when construction is split.
+  // Under a first-touch memory policy this influences the memory node pages are
+  // placed on, but the worker threads aren't pinned and no memory policy is set
+  // so the placement isn't guaranteed.
+  //
+  // NUMA_LOCAL      - each thread initializes one contiguous range of the
+  //                   array, split like a later parallel operation would be
+  // NUMA_INTERLEAVE - each thread initializes every n-th page in turn
+  enum NArrayNumaType
+  {
+    NUMA_LOCAL,
+    NUMA_INTERLEAVE
+  };
+
+  // Determines the kind of memory pages that back an array.
+  //
+  // DEFAULT_PAGES       - uses huge pages if the array is at least as large as
+  //                       the threshold set by setHugePageThreshold()
+  // REGULAR_PAGES       - uses the standard allocator
+  // HUGE_PAGES          - aligns the data to 2MB and advises the system to back
+  //                       it with transparent huge pages
+  // HUGE_PAGES_PREFAULT - same as HUGE_PAGES but also touches every page when
+  //                       allocating, even if the elements are left
+  //                       uninitialized
+  //
+  // NOTE: huge pages are only used on Linux, elsewhere they fall back to the
+  //       standard allocator
+  enum NArrayStorageType
+  {
+    DEFAULT_PAGES,
+    REGULAR_PAGES,
+    HUGE_PAGES,
+    HUGE_PAGES_PREFAULT
+  };
+
+namespace detail
+{
+  // The size of memory pages assumed when interleaving.
+  constexpr std::size_t NUMA_PAGE_BYTES = 4096;
+
+  inline std::atomic<NArrayNumaType>& numaPolicyValue() noexcept
+  {
+    static std::atomic<NArrayNumaType> policy(NUMA_LOCAL);
+    return policy;
+  }
+
+} // namespace detail
+
+  //! @brief         sets the policy used to place the pages of new arrays
+  //! @param[in]     policy - the new policy
+  inline void setNumaPolicy(NArrayNumaType policy) noexcept
+  {
+    detail::numaPolicyValue().store(policy);
+  }
+
+  //! @brief         gets the policy used to place the pages of new arrays
+  //! @return        the current policy, NUMA_LOCAL by default
+  inline NArrayNumaType numaPolicy() noexcept
+  {
+    return detail::numaPolicyValue().load();
+  }
+
+namespace detail
+{
+  // The size and alignment of transparent huge pages.
+  constexpr std::size_t HUGE_PAGE_BYTES = std::size_t(1) << 21;
+
+  inline std::atomic<std::size_t>& hugePageThresholdValue() noexcept
+  {
+    static std::atomic<std::size_t> threshold(std::numeric_limits<std::size_t>::max());
+    return threshold;
+  }
+
+  inline std::atomic<bool>& hugePagePrefaultValue() noexcept
+  {
+    static std::atomic<bool> prefault(false);
+    return prefault;
+  }
+
+  // Gets the storage that a block of 'bytes' bytes should use when 'storage'
+  // is DEFAULT_PAGES.
+  inline NArrayStorageType resolveStorage(NArrayStorageType storage, std::size_t bytes) noexcept
+  {
+    if (storage != DEFAULT_PAGES)
+      return storage;
+    if (bytes < hugePageThresholdValue().load())
+      return REGULAR_PAGES;
+    return hugePagePrefaultValue().load() ? HUGE_PAGES_PREFAULT : HUGE_PAGES;
+  }
+
+} // namespace detail
+
+  //! @brief         sets the size from which arrays use huge pages by default
+  //! @param[in]     bytes - the smallest array size in bytes that will use huge
+  //!                pages, or the maximum size_t to disable them (the default)
+  //! @param[in]     prefault - whether those arrays are pre-faulted
+  inline void setHugePageThreshold(std::size_t bytes, bool prefault = false) noexcept
+  {
+    detail::hugePageThresholdValue().store(bytes);
+    detail::hugePagePrefaultValue().store(prefault);
+  }
+
+  //! @brief         gets the size from which arrays use huge pages by default
+  //! @return        the threshold in bytes
+  inline std::size_t hugePageThreshold() noexcept
+  {
+    return detail::hugePageThresholdValue().load();
+  }
+
 namespace detail
 {
+  // Calls 'func(begin, end)' on ranges that together cover the 'size' elements
+  // of a new block, split across threads according to the current
+  // NArrayNumaType. Under NUMA_LOCAL the ranges match how parallelFor() would
+  // split the elements, though the threads that run them can differ.
+  //
+  // Notes:
+  // - 'func' must not throw if 'parallel' is true
+  template <class T, class Function>
+  void firstTouch(std::size_t size, bool parallel, Function func)
+  {
+    const std::size_t chunks = parallel ? chunkCount((pos_t)size, PARALLEL_GRAIN) : 1;
+    if (chunks <= 1)
+    {
+      func(std::size_t(0), size);
+      return;
+    }
+
+    if (numaPolicy() == NUMA_INTERLEAVE)
+    {
+      const std::size_t page = std::max<std::size_t>(1, NUMA_PAGE_BYTES / sizeof(T));
+      const std::size_t pages = (size + page - 1) / page;
+      parallelChunks((pos_t)chunks, chunks, [&](std::size_t c, pos_t, pos_t) {
+        for (std::size_t p = c; p < pages; p += chunks)
+          func(p * page, std::min(size, (p + 1) * page));
+      });
+    }
+    else
+    {
+      parallelChunks((pos_t)size, chunks, [&](std::size_t, pos_t begin, pos_t end) {
+        func((std::size_t)begin, (std::size_t)end);
+      });
+    }
+  }
+
+  // The deleter of the shared data of arrays, destroys the elements and frees
+  // the memory allocated by an NArrayDataBlock. It also keeps the size of the
+  // data so it can be looked up from any array sharing it.
   template <class T, class A = std::allocator<T>>
-  class NArrayDataBlock : public std::enable_shared_from_this<NArrayDataBlock<T, A>>
+  struct NArrayDataBlockDeleter
+  {
+    std::size_t size;
+    A alloc;
+    bool owned;
+    bool huge;
+
+    void operator() (T* data)
+    {
+      if (!data || !owned)
+        return;
+
+      WILT_NARRAY_UNTRACK_BLOCK(data);
+
+      if (!std::is_trivially_destructible<T>::value)
+        for (std::size_t i = 0; i < size; ++i)
+          std::allocator_traits<A>::destroy(alloc, data + i);
+      if (huge)
+        std::free(data);
+      else
+        std::allocator_traits<A>::deallocate(alloc, data, size);
+    }
+  };
+
+  //! @brief         gets the size of the data block that shared data belongs to
+  //! @param[in]     data - the shared data of an array
+  //! @return        the size of the block in bytes, or 0 if the data wasn't
+  //!                allocated by an NArrayDataBlock or isn't owned by it
+  template <class T>
+  std::size_t blockBytes(const std::shared_ptr<T>& data) noexcept
+  {
+    using U = typename std::remove_const<T>::type;
+
+    auto deleter = std::get_deleter<NArrayDataBlockDeleter<U>>(data);
+    if (!deleter || !deleter->owned)
+      return 0;
+    return deleter->size * sizeof(U);
+  }
+
+  // Allocates and initializes the data for an array, which is then handed off
+  // to a shared pointer by data().
+  template <class T, class A = std::allocator<T>>
+  class NArrayDataBlock
   {
   private:
     ////////////////////////////////////////////////////////////////////////////
@@ -55,6 +258,7 @@ namespace detail
     std::size_t size_;
     A alloc_;
     bool owned_;
+    bool huge_;
 
   public:
     ////////////////////////////////////////////////////////////////////////////
@@ -65,49 +269,60 @@ namespace detail
       : data_(nullptr),
         size_(0),
         alloc_(),
-        owned_(true)
+        owned_(true),
+        huge_(false)
     {
 
     }
 
-    NArrayDataBlock(std::size_t size)
+    NArrayDataBlock(std::size_t size, NArrayStorageType storage = DEFAULT_PAGES)
       : data_(nullptr),
         size_(size),
         alloc_(),
-        owned_(true)
+        owned_(true),
+        huge_(false)
     {
-      data_ = std::allocator_traits<A>::allocate(alloc_, size);
+      data_ = allocate_(size, storage);
       if (!std::is_trivially_default_constructible<T>::value)
-        for (std::size_t i = 0; i < size; ++i)
-          std::allocator_traits<A>::construct(alloc_, data_ + i);
+        firstTouch<T>(size, std::is_nothrow_default_constructible<T>::value, [this](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i)
+            std::allocator_traits<A>::construct(alloc_, data_ + i);
+        });
     }
 
-    NArrayDataBlock(std::size_t size, const T& val)
+    NArrayDataBlock(std::size_t size, const T& val, NArrayStorageType storage = DEFAULT_PAGES)
       : data_(nullptr),
         size_(size),
         alloc_(),
-        owned_(true)
+        owned_(true),
+        huge_(false)
     {
-      data_ = std::allocator_traits<A>::allocate(alloc_, size);
-      for (std::size_t i = 0; i < size; ++i)
-        std::allocator_traits<A>::construct(alloc_, data_ + i, val);
+      data_ = allocate_(size, storage);
+      firstTouch<T>(size, std::is_nothrow_copy_constructible<T>::value, [this, &val](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+          std::allocator_traits<A>::construct(alloc_, data_ + i, val);
+      });
     }
 
     NArrayDataBlock(std::size_t size, T* data, NArrayDataAcquireType atype)
       : data_(nullptr),
         size_(size),
         alloc_(),
-        owned_(true)
+        owned_(true),
+        huge_(false)
     {
       switch (atype)
       {
       case wilt::ASSUME:
         data_ = data;
+        WILT_NARRAY_TRACK_BLOCK(data_, size * sizeof(T));
         break;
       case wilt::COPY:
-        data_ = std::allocator_traits<A>::allocate(alloc_, size);
-        for (size_t i = 0; i < size; ++i)
-          std::allocator_traits<A>::construct(alloc_, data_ + i, data[i]);
+        data_ = allocate_(size, DEFAULT_PAGES);
+        firstTouch<T>(size, std::is_nothrow_copy_constructible<T>::value, [this, data](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i)
+            std::allocator_traits<A>::construct(alloc_, data_ + i, data[i]);
+        });
         break;
       case wilt::REFERENCE:
         data_ = data;
@@ -121,9 +336,18 @@ namespace detail
       : data_(nullptr),
         size_(size),
         alloc_(),
-        owned_(true)
+        owned_(true),
+        huge_(false)
     {
-      data_ = std::allocator_traits<A>::allocate(alloc_, size);
+      data_ = allocate_(size, DEFAULT_PAGES);
+
+      // the generator has to be called in order, but trivial elements can
+      // still have their pages placed before it runs
+      if (std::is_trivial<T>::value && chunkCount((pos_t)size, PARALLEL_GRAIN) > 1)
+        firstTouch<T>(size, true, [this](std::size_t begin, std::size_t end) {
+          std::fill(reinterpret_cast<unsigned char*>(data_ + begin), reinterpret_cast<unsigned char*>(data_ + end), (unsigned char)0);
+        });
+
       for (std::size_t i = 0; i < size; ++i)
         std::allocator_traits<A>::construct(alloc_, data_ + i, gen());
     }
@@ -133,9 +357,10 @@ namespace detail
       : data_(nullptr),
         size_(size),
         alloc_(),
-        owned_(true)
+        owned_(true),
+        huge_(false)
     {
-      data_ = std::allocator_traits<A>::allocate(alloc_, size);
+      data_ = allocate_(size, DEFAULT_PAGES);
 
       std::size_t i = 0;
       for (; i < size && first != last; ++i, ++first)
@@ -146,15 +371,12 @@ namespace detail
           std::allocator_traits<A>::construct(alloc_, data_ + i);
     }
 
+    NArrayDataBlock(const NArrayDataBlock&) = delete;
+    NArrayDataBlock& operator= (const NArrayDataBlock&) = delete;
+
     ~NArrayDataBlock()
     {
-      if (data_ && owned_)
-      {
-        if (!std::is_trivially_destructible<T>::value)
-          for (std::size_t i = 0; i < size_; ++i)
-            std::allocator_traits<A>::destroy(alloc_, data_ + i);
-        std::allocator_traits<A>::deallocate(alloc_, data_, size_);
-      }
+      deleter_()(data_);
     }
 
   public:
@@ -162,9 +384,66 @@ namespace detail
     // ACCESS FUNCTIONS
     ////////////////////////////////////////////////////////////////////////////
 
-    std::shared_ptr<T> data() const
+    // Hands off the data to a shared pointer that destroys it once the last
+    // array using it is gone, the block is empty afterwards
+    std::shared_ptr<T> data()
+    {
+      T* data = data_;
+      data_ = nullptr;
+      return std::shared_ptr<T>(data, deleter_());
+    }
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    // PRIVATE FUNCTIONS
+    ////////////////////////////////////////////////////////////////////////////
+
+    T* allocate_(std::size_t size, NArrayStorageType storage)
+    {
+      storage = resolveStorage(storage, size * sizeof(T));
+      WILT_NARRAY_COUNT(ALLOCATIONS, 1);
+      WILT_NARRAY_COUNT(ALLOCATED_BYTES, size * sizeof(T));
+
+      if (storage == REGULAR_PAGES || !std::is_same<A, std::allocator<T>>::value)
+        return track_(std::allocator_traits<A>::allocate(alloc_, size), size);
+
+#if defined(__linux__)
+      if (size > (std::numeric_limits<std::size_t>::max() - HUGE_PAGE_BYTES) / sizeof(T))
+        throw std::bad_alloc();
+
+      const std::size_t bytes = (size * sizeof(T) + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+      void* ptr = nullptr;
+      if (::posix_memalign(&ptr, HUGE_PAGE_BYTES, bytes) != 0)
+        throw std::bad_alloc();
+#if defined(MADV_HUGEPAGE)
+      ::madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+      huge_ = true;
+
+      if (storage == HUGE_PAGES_PREFAULT)
+      {
+        unsigned char* base = static_cast<unsigned char*>(ptr);
+        firstTouch<T>(size, true, [base](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin * sizeof(T); i < end * sizeof(T); i = (i / NUMA_PAGE_BYTES + 1) * NUMA_PAGE_BYTES)
+            base[i] = 0;
+        });
+      }
+
+      return track_(static_cast<T*>(ptr), size);
+#else
+      return track_(std::allocator_traits<A>::allocate(alloc_, size), size);
+#endif
+    }
+
+    NArrayDataBlockDeleter<T, A> deleter_() const
+    {
+      return NArrayDataBlockDeleter<T, A>{ size_, alloc_, owned_, huge_ };
+    }
+
+    static T* track_(T* data, std::size_t size)
     {
-      return std::shared_ptr<T>(this->shared_from_this(), data_);
+      WILT_NARRAY_TRACK_BLOCK(data, size * sizeof(T));
+      return data;
     }
 
   }; // class NArrayDataBlock
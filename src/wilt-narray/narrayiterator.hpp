@@ -166,11 +166,13 @@ namespace detail
 
     value_type operator* () const
     {
+      WILT_NARRAY_COUNT(DEREFERENCES, 1);
       return at_(position_);
     }
 
     value_type operator[] (pos_t pos) const
     {
+      WILT_NARRAY_COUNT(DEREFERENCES, 1);
       auto newposition = position_;
       wilt::detail::addValueToPosition(newposition, array_->sizes().data(), pos);
       return at_(newposition);
@@ -32,6 +32,8 @@
 #include <stdexcept>
 #include <utility>
 
+#include "checks.hpp"
+
 namespace wilt
 {
   // - defined in "narray.hpp"
@@ -53,8 +55,8 @@ namespace wilt
   template <class T, class U, std::size_t N>                                        \
   NArray<bool, N> NAME(const NArray<T, N>& lhs, const NArray<U, N>& rhs)            \
   {                                                                                 \
-    if (lhs.sizes() != rhs.sizes())                                                 \
-      throw std::invalid_argument(#NAME "(): dimensions must match");               \
+    WILT_NARRAY_CHECK(lhs.sizes() == rhs.sizes(), std::invalid_argument,           \
+                      #NAME "(): dimensions must match");                           \
     if (lhs.empty())                                                                \
       return NArray<bool, N>();                                                     \
                                                                                     \
@@ -90,8 +92,7 @@ namespace wilt
   template <class Ret, class T, class U, std::size_t N>                                                                      \
   NArray<Ret, N> NAME(const NArray<T, N>& lhs, const NArray<U, N>& rhs)                                                      \
   {                                                                                                                          \
-    if (lhs.sizes() != rhs.sizes())                                                                                          \
-      throw std::invalid_argument(#NAME "(): dimensions must match");                                                        \
+    WILT_NARRAY_CHECK(lhs.sizes() == rhs.sizes(), std::invalid_argument, #NAME "(): dimensions must match");                  \
     if (lhs.empty())                                                                                                         \
       return NArray<Ret, N>();                                                                                               \
                                                                                                                              \
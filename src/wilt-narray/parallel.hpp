@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: parallel.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines helpers for splitting bulk operations across threads
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_PARALLEL_HPP
+#define WILT_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "util.hpp"
+
+namespace wilt
+{
+namespace detail
+{
+  // The approximate number of elements that are worth handing off to another
+  // thread. Operations are not split any finer than this.
+  constexpr pos_t PARALLEL_GRAIN = 1 << 15;
+
+  // Gets the number of threads that bulk operations may be split across. This
+  // is always 1 unless `WILT_NARRAY_PARALLEL` is defined, in which case it is
+  // the number of hardware threads available or `WILT_NARRAY_THREADS` if it is
+  // defined.
+  inline std::size_t threadCount() noexcept
+  {
+#if defined(WILT_NARRAY_PARALLEL) && defined(WILT_NARRAY_THREADS)
+    return std::max<std::size_t>(1, WILT_NARRAY_THREADS);
+#elif defined(WILT_NARRAY_PARALLEL)
+    static const std::size_t count = std::max(1u, std::thread::hardware_concurrency());
+    return count;
+#else
+    return 1;
+#endif
+  }
+
+  // Gets the number of chunks that 'count' items should be split into so that
+  // each chunk has at least 'grain' items and there aren't more chunks than
+  // threads.
+  inline std::size_t chunkCount(pos_t count, pos_t grain) noexcept
+  {
+    if (count <= 0)
+      return 0;
+
+    pos_t chunks = count / std::max<pos_t>(grain, 1);
+    return (std::size_t)std::max<pos_t>(1, std::min<pos_t>(chunks, (pos_t)threadCount()));
+  }
+
+  // Gets the first item of a chunk. Chunk 'c' covers the items from
+  // 'chunkBegin(count, chunks, c)' to 'chunkBegin(count, chunks, c+1)'.
+  inline pos_t chunkBegin(pos_t count, std::size_t chunks, std::size_t c) noexcept
+  {
+    return (pos_t)(count * (pos_t)c / (pos_t)chunks);
+  }
+
+  // Calls 'func(c, begin, end)' for each chunk 'c' of the 'count' items split
+  // into 'chunks' chunks. The first chunk is run on the calling thread and the
+  // rest are each run on their own thread.
+  //
+  // Notes:
+  // - 'func' must be safe to call concurrently on different chunks
+  // - if any call throws, the first exception is rethrown after all the calls
+  //   have completed
+  template <class Function>
+  void parallelChunks(pos_t count, std::size_t chunks, Function func)
+  {
+    if (chunks == 0)
+      return;
+    if (chunks == 1)
+    {
+      func(std::size_t(0), pos_t(0), count);
+      return;
+    }
+
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto run = [&](std::size_t c) {
+      try
+      {
+        func(c, chunkBegin(count, chunks, c), chunkBegin(count, chunks, c + 1));
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error)
+          error = std::current_exception();
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(chunks - 1);
+    for (std::size_t c = 1; c < chunks; ++c)
+      threads.emplace_back(run, c);
+    run(0);
+    for (auto& thread : threads)
+      thread.join();
+
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  // Calls 'func(begin, end)' on segments that together cover the 'count' items.
+  // The segments are run on separate threads if each would have at least
+  // 'grain' items, otherwise 'func(0, count)' is called on the calling thread.
+  //
+  // Notes:
+  // - 'func' must be safe to call concurrently on different segments
+  template <class Function>
+  void parallelFor(pos_t count, pos_t grain, Function func)
+  {
+    parallelChunks(count, chunkCount(count, grain), [&func](std::size_t, pos_t begin, pos_t end) { func(begin, end); });
+  }
+
+} // namespace detail
+
+} // namespace wilt
+
+#endif // !WILT_PARALLEL_HPP
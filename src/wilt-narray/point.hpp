@@ -28,7 +28,6 @@
 #ifndef WILT_POINT_HPP
 #define WILT_POINT_HPP
 
-#include <array>
 #include <cstddef>
 #include <initializer_list>
 #include <stdexcept>
@@ -42,10 +41,10 @@ namespace wilt
   //////////////////////////////////////////////////////////////////////////////
   // This class is designed to resemble an N-dimensional integral-point object.
   //
-  // This class is basically a wrapper around an `std::array<int, N>` member
-  // that provides both functions and semantics to use it as a generic integral-
-  // point object as well as those needed to manipulate the dimensions as
-  // required by the `NArray` class.
+  // This class is basically a wrapper around an `int[N]` member that provides
+  // both functions and semantics to use it as a generic integral-point object
+  // as well as those needed to manipulate the dimensions as required by the
+  // `NArray` class.
   //
   // The point has the traditional access methods like `operator[]` and `data()`
   // but it also provides the expected mathematical operators (`+`, `-`, `*`,
@@ -62,7 +61,9 @@ namespace wilt
     // PRIVATE MEMBERS
     ////////////////////////////////////////////////////////////////////////////
 
-    std::array<pos_t, N> data_; // internal storage
+    // internal storage, a plain array instead of `std::array` since its
+    // non-const access isn't constexpr until C++17
+    pos_t data_[N == 0 ? 1 : N];
 
   public:
     ////////////////////////////////////////////////////////////////////////////
@@ -85,8 +86,11 @@ namespace wilt
 
     // Creates a point with values copied from another point
     constexpr Point(const Point<N>& pt) noexcept
-      : data_{ pt.data_ }
-    { }
+      : data_{ }
+    {
+      for (std::size_t i = 0; i < N; ++i)
+        data_[i] = pt.data_[i];
+    }
 
   public:
     ////////////////////////////////////////////////////////////////////////////
@@ -96,7 +100,8 @@ namespace wilt
     // Copies values from another point
     constexpr Point<N>& operator = (const Point<N>& pt) noexcept
     {
-      data_ = pt.data_;
+      for (std::size_t i = 0; i < N; ++i)
+        data_[i] = pt.data_[i];
       return *this;
     }
 
@@ -163,12 +168,12 @@ namespace wilt
 
     constexpr pos_t* data() noexcept
     {
-      return data_.data();
+      return data_;
     }
 
     constexpr const pos_t* data() const noexcept
     {
-      return data_.data();
+      return data_;
     }
 
   public:
@@ -219,7 +224,8 @@ namespace wilt
     constexpr Point<N> swapped(std::size_t a, std::size_t b) const noexcept
     {
       Point<N> ret = *this;
-      std::swap(ret.data_[a], ret.data_[b]);
+      ret.data_[a] = data_[b];
+      ret.data_[b] = data_[a];
       return ret;
     }
 
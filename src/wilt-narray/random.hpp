@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: random.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines functions that fill an NArray with random values
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_RANDOM_HPP
+#define WILT_RANDOM_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "narray.hpp"
+#include "algorithms.hpp"
+#include "parallel.hpp"
+
+namespace wilt
+{
+namespace detail
+{
+  // The `Philox4x32` class is a counter-based random number generator, the
+  // Philox-4x32-10 generator from "Parallel Random Numbers: As Easy as 1, 2,
+  // 3" (Salmon et al). Rather than advancing a state, each output is a keyed
+  // bijection of a counter, so any element can be generated independently of
+  // the others from its position alone.
+  class Philox4x32
+  {
+  public:
+    static void generate(std::uint64_t counter, std::uint64_t seed, std::uint32_t (&out)[4]) noexcept
+    {
+      std::uint32_t key0 = std::uint32_t(seed);
+      std::uint32_t key1 = std::uint32_t(seed >> 32);
+
+      out[0] = std::uint32_t(counter);
+      out[1] = std::uint32_t(counter >> 32);
+      out[2] = 0;
+      out[3] = 0;
+
+      for (int i = 0; i < 10; ++i)
+      {
+        const std::uint64_t p0 = std::uint64_t(0xD2511F53u) * out[0];
+        const std::uint64_t p1 = std::uint64_t(0xCD9E8D57u) * out[2];
+        const std::uint32_t c1 = out[1];
+        const std::uint32_t c3 = out[3];
+
+        out[0] = std::uint32_t(p1 >> 32) ^ c1 ^ key0;
+        out[1] = std::uint32_t(p1);
+        out[2] = std::uint32_t(p0 >> 32) ^ c3 ^ key1;
+        out[3] = std::uint32_t(p0);
+
+        key0 += 0x9E3779B9u;
+        key1 += 0xBB67AE85u;
+      }
+    }
+  };
+
+  // Gets a double in [0, 1) from two random words, using 53 bits.
+  inline double uniformDouble(std::uint32_t hi, std::uint32_t lo) noexcept
+  {
+    return double(((std::uint64_t(hi) << 32) | lo) >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  // Fills 'arr' by calling 'func(word)' for each element with the random
+  // words for its position, counted in order. The results only depend on the
+  // seed and the positions, not on the layout of the array or on how the work
+  // is split between threads.
+  template <class T, std::size_t N, class Function>
+  void randomFill(const NArray<T, N>& arr, std::uint64_t seed, Function func)
+  {
+    if (arr.empty())
+      return;
+
+    Point<N> sizes = arr.sizes();
+    Point<N> steps = arr.steps();
+    condense(sizes, steps);
+
+    parallelFor((pos_t)arr.size(), PARALLEL_GRAIN, [&](pos_t begin, pos_t end) {
+      pos_t n = begin;
+      auto run = [&](T* data, pos_t step, pos_t count) {
+        for (pos_t i = 0; i < count; ++i, ++n)
+        {
+          std::uint32_t words[4];
+          Philox4x32::generate(std::uint64_t(n), seed, words);
+          data[i * step] = func(words);
+        }
+      };
+      forRuns(arr.data(), sizes, steps, begin, end, run);
+    });
+  }
+
+  template <class T>
+  T uniformValue(const std::uint32_t (&words)[4], T lo, T hi, std::true_type) noexcept
+  {
+    // the difference is wrapped back into U since small types are promoted to
+    // int, which would make it negative if 'lo' is negative
+    using U = typename std::make_unsigned<T>::type;
+    const std::uint64_t range = std::uint64_t(U(U(hi) - U(lo))) + 1;
+    const std::uint64_t word = (std::uint64_t(words[0]) << 32) | words[1];
+    return T(U(U(lo) + U(range == 0 ? word : word % range)));
+  }
+
+  template <class T>
+  T uniformValue(const std::uint32_t (&words)[4], T lo, T hi, std::false_type) noexcept
+  {
+    // rounding, either in the arithmetic or when narrowing to float, can land
+    // exactly on 'hi' so it is moved back inside the range
+    const T ret = T(lo + (hi - lo) * uniformDouble(words[0], words[1]));
+    return ret < hi ? ret : std::nextafter(hi, lo);
+  }
+
+} // namespace detail
+
+  //! @brief         fills an array with uniformly distributed random values
+  //! @param[in]     arr - the array to fill
+  //! @param[in]     lo - the lowest value
+  //! @param[in]     hi - the highest value, is included for integer types and
+  //!                excluded for floating point types
+  //! @param[in]     seed - the seed for the generator
+  //!
+  //! The value of each element only depends on the seed and its position in
+  //! the array, so the results are the same for any layout of the array and
+  //! any number of threads. Elements are filled in parallel when enabled.
+  template <class T, std::size_t N>
+  void randomUniform(const NArray<T, N>& arr, T lo, T hi, std::uint64_t seed)
+  {
+    static_assert(!std::is_const<T>::value, "randomUniform(arr, lo, hi, seed): invalid when element type is const");
+    static_assert(std::is_arithmetic<T>::value, "randomUniform(arr, lo, hi, seed): element type must be arithmetic");
+
+    if (hi < lo)
+      throw std::invalid_argument("randomUniform(arr, lo, hi, seed): lo must not be greater than hi");
+
+    detail::randomFill(arr, seed, [lo, hi](const std::uint32_t (&words)[4]) {
+      return detail::uniformValue(words, lo, hi, std::is_integral<T>());
+    });
+  }
+
+  //! @brief         fills an array with normally distributed random values
+  //! @param[in]     arr - the array to fill
+  //! @param[in]     mean - the mean of the distribution
+  //! @param[in]     stddev - the standard deviation of the distribution
+  //! @param[in]     seed - the seed for the generator
+  //!
+  //! Values are generated with the Box-Muller transform. As with
+  //! randomUniform(), the value of each element only depends on the seed and
+  //! its position in the array.
+  template <class T, std::size_t N>
+  void randomNormal(const NArray<T, N>& arr, T mean, T stddev, std::uint64_t seed)
+  {
+    static_assert(!std::is_const<T>::value, "randomNormal(arr, mean, stddev, seed): invalid when element type is const");
+    static_assert(std::is_floating_point<T>::value, "randomNormal(arr, mean, stddev, seed): element type must be floating point");
+
+    if (stddev < T(0))
+      throw std::invalid_argument("randomNormal(arr, mean, stddev, seed): stddev must not be negative");
+
+    detail::randomFill(arr, seed, [mean, stddev](const std::uint32_t (&words)[4]) {
+      const double pi = 3.14159265358979323846;
+      const double u1 = 1.0 - detail::uniformDouble(words[0], words[1]);
+      const double u2 = detail::uniformDouble(words[2], words[3]);
+      return T(mean + stddev * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * pi * u2));
+    });
+  }
+
+} // namespace wilt
+
+#endif // !WILT_RANDOM_HPP
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: stats.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines opt-in counters for the hot paths of the library
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_STATS_HPP
+#define WILT_STATS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Counts an event on the current thread if `WILT_NARRAY_STATS` is defined,
+// otherwise does nothing and doesn't evaluate its arguments.
+//
+// The macro must be defined the same way in every translation unit of a
+// program since it changes the bodies of inline functions and templates.
+#if defined(WILT_NARRAY_STATS)
+#define WILT_NARRAY_COUNT(counter, n) ::wilt::detail::statsAdd(::wilt::detail::counter, (std::uint64_t)(n))
+#define WILT_NARRAY_COUNT_KERNEL(dims) ::wilt::detail::statsAdd(::wilt::detail::kernelCounter(dims), 1)
+#else
+#define WILT_NARRAY_COUNT(counter, n) ((void)0)
+#define WILT_NARRAY_COUNT_KERNEL(dims) ((void)sizeof(dims))
+#endif
+
+namespace wilt
+{
+  // Kernels with more dimensions than this after condensing are counted
+  // together in the last slot.
+  constexpr std::size_t STATS_MAX_DIMS = 8;
+
+  // Counts of the events that library operations have made across all threads.
+  // These are only gathered if `WILT_NARRAY_STATS` is defined, otherwise they
+  // are always zero.
+  struct NArrayStats
+  {
+    std::uint64_t allocations;                    // data blocks allocated
+    std::uint64_t allocatedBytes;                 // bytes allocated for those blocks
+    std::uint64_t clones;                         // calls to clone()
+    std::uint64_t clonedBytes;                    // bytes copied by clone()
+    std::uint64_t dereferences;                   // iterator dereferences
+    std::uint64_t views;                          // arrays made by transformations, each
+                                                  // holding a shared_ptr copy
+    std::uint64_t kernels[STATS_MAX_DIMS + 1];    // element-wise kernel calls, indexed by
+                                                  // dimensionality after condensing
+  };
+
+namespace detail
+{
+  enum NArrayStatsCounter
+  {
+    ALLOCATIONS,
+    ALLOCATED_BYTES,
+    CLONES,
+    CLONED_BYTES,
+    DEREFERENCES,
+    VIEWS,
+    KERNELS,
+    STATS_COUNTERS = KERNELS + STATS_MAX_DIMS + 1
+  };
+
+  inline std::size_t kernelCounter(std::size_t dims) noexcept
+  {
+    return KERNELS + std::min(dims, STATS_MAX_DIMS);
+  }
+
+  // The counters of a single thread. Only the owning thread writes to them so
+  // they are updated without read-modify-write operations, the atomics only
+  // make it safe to read them from other threads.
+  struct ThreadStats
+  {
+    std::atomic<std::uint64_t> counts[STATS_COUNTERS];
+
+    ThreadStats();
+    ~ThreadStats();
+  };
+
+  // Keeps track of the counters of all live threads and the totals of threads
+  // that have exited.
+  struct StatsRegistry
+  {
+    std::mutex mutex;
+    std::vector<ThreadStats*> threads;
+    std::uint64_t retired[STATS_COUNTERS] = { };
+
+    static StatsRegistry& instance()
+    {
+      static StatsRegistry registry;
+      return registry;
+    }
+  };
+
+  inline ThreadStats::ThreadStats()
+  {
+    for (auto& count : counts)
+      count.store(0, std::memory_order_relaxed);
+
+    StatsRegistry& registry = StatsRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.push_back(this);
+  }
+
+  inline ThreadStats::~ThreadStats()
+  {
+    StatsRegistry& registry = StatsRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (std::size_t i = 0; i < STATS_COUNTERS; ++i)
+      registry.retired[i] += counts[i].load(std::memory_order_relaxed);
+    registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+  }
+
+  inline ThreadStats& threadStats()
+  {
+    static thread_local ThreadStats stats;
+    return stats;
+  }
+
+  inline void statsAdd(std::size_t counter, std::uint64_t n)
+  {
+    std::atomic<std::uint64_t>& count = threadStats().counts[counter];
+    count.store(count.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+} // namespace detail
+
+  //! @brief         gets the counts gathered so far across all threads
+  //! @return        the sum of the counts since the last resetStats()
+  //!
+  //! Counts made concurrently by other threads may or may not be included.
+  inline NArrayStats snapshotStats()
+  {
+    std::uint64_t totals[detail::STATS_COUNTERS];
+
+    detail::StatsRegistry& registry = detail::StatsRegistry::instance();
+    {
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      for (std::size_t i = 0; i < detail::STATS_COUNTERS; ++i)
+        totals[i] = registry.retired[i];
+      for (detail::ThreadStats* thread : registry.threads)
+        for (std::size_t i = 0; i < detail::STATS_COUNTERS; ++i)
+          totals[i] += thread->counts[i].load(std::memory_order_relaxed);
+    }
+
+    NArrayStats stats;
+    stats.allocations = totals[detail::ALLOCATIONS];
+    stats.allocatedBytes = totals[detail::ALLOCATED_BYTES];
+    stats.clones = totals[detail::CLONES];
+    stats.clonedBytes = totals[detail::CLONED_BYTES];
+    stats.dereferences = totals[detail::DEREFERENCES];
+    stats.views = totals[detail::VIEWS];
+    for (std::size_t i = 0; i <= STATS_MAX_DIMS; ++i)
+      stats.kernels[i] = totals[detail::KERNELS + i];
+    return stats;
+  }
+
+  //! @brief         sets all the counts back to zero
+  //!
+  //! Counts made concurrently by other threads may be lost or kept, so this
+  //! should be called while other threads aren't using the library.
+  inline void resetStats()
+  {
+    detail::StatsRegistry& registry = detail::StatsRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& count : registry.retired)
+      count = 0;
+    for (detail::ThreadStats* thread : registry.threads)
+      for (auto& count : thread->counts)
+        count.store(0, std::memory_order_relaxed);
+  }
+
+} // namespace wilt
+
+#endif // !WILT_STATS_HPP
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: trace.hpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Defines optional tracing hooks around bulk operations
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WILT_TRACE_HPP
+#define WILT_TRACE_HPP
+
+#include <atomic>
+#include <cstddef>
+
+#include "point.hpp"
+
+// Reports the start of a bulk operation on 'arr' to the trace callback, and its
+// end when the enclosing scope exits, if `WILT_NARRAY_TRACE` is defined.
+// Otherwise does nothing and doesn't evaluate its arguments.
+//
+// The macro must be defined the same way in every translation unit of a
+// program since it changes the bodies of inline functions and templates.
+#if defined(WILT_NARRAY_TRACE)
+#define WILT_NARRAY_TRACE_SCOPE(name, arr) ::wilt::detail::TraceScope wiltTraceScope_(name, (arr).sizes(), (arr).steps(), sizeof(*(arr).data()))
+#else
+#define WILT_NARRAY_TRACE_SCOPE(name, arr) ((void)0)
+#endif
+
+namespace wilt
+{
+  enum NArrayTracePhase
+  {
+    TRACE_BEGIN,
+    TRACE_END
+  };
+
+  // Describes a bulk operation and the array it operates on, which is the
+  // destination if it has one. 'sizes' and 'steps' both have 'dims' values.
+  struct NArrayTraceEvent
+  {
+    const char* name;
+    std::size_t dims;
+    const pos_t* sizes;
+    const pos_t* steps;
+    std::size_t elementSize;
+  };
+
+  // The signature of trace callbacks, they are called on the thread running
+  // the operation and must not throw.
+  using NArrayTraceCallback = void (*)(NArrayTracePhase phase, const NArrayTraceEvent& event);
+
+namespace detail
+{
+  inline std::atomic<NArrayTraceCallback>& traceCallbackValue() noexcept
+  {
+    static std::atomic<NArrayTraceCallback> callback(nullptr);
+    return callback;
+  }
+
+  // Calls the trace callback when constructed and destructed. The callback is
+  // read once so that the calls stay paired if it is changed in between.
+  class TraceScope
+  {
+  public:
+    template <std::size_t N>
+    TraceScope(const char* name, const Point<N>& sizes, const Point<N>& steps, std::size_t elementSize) noexcept
+      : callback_(traceCallbackValue().load(std::memory_order_acquire)),
+        event_{ name, N, sizes.data(), steps.data(), elementSize }
+    {
+      if (callback_)
+        callback_(TRACE_BEGIN, event_);
+    }
+
+    ~TraceScope()
+    {
+      if (callback_)
+        callback_(TRACE_END, event_);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator= (const TraceScope&) = delete;
+
+  private:
+    NArrayTraceCallback callback_;
+    NArrayTraceEvent event_;
+  };
+
+} // namespace detail
+
+  //! @brief         sets the function called at the start and end of each bulk
+  //!                operation when `WILT_NARRAY_TRACE` is defined
+  //! @param[in]     callback - the new callback, or nullptr to stop tracing
+  inline void setTraceCallback(NArrayTraceCallback callback) noexcept
+  {
+    detail::traceCallbackValue().store(callback, std::memory_order_release);
+  }
+
+  //! @brief         gets the current trace callback
+  //! @return        the callback, or nullptr if there is none
+  inline NArrayTraceCallback traceCallback() noexcept
+  {
+    return detail::traceCallbackValue().load(std::memory_order_acquire);
+  }
+
+} // namespace wilt
+
+#endif // !WILT_TRACE_HPP
@@ -30,9 +30,13 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "point.hpp"
+#include "stats.hpp"
 
 namespace wilt
 {
@@ -41,6 +45,176 @@ namespace wilt
 
 namespace detail
 {
+  // Gets the absolute value, 'std::abs()' isn't constexpr until C++23
+  constexpr pos_t absolute(pos_t v) noexcept
+  {
+    return v < 0 ? -v : v;
+  }
+
+  // Swaps two positions, 'std::swap()' isn't constexpr until C++20
+  constexpr void swapValues(pos_t& a, pos_t& b) noexcept
+  {
+    pos_t t = a;
+    a = b;
+    b = t;
+  }
+
+  //! @brief         Condenses a dim array and steps array into smaller arrays
+  //!                if able to
+  //! @param[in,out] sizes - dimension array as a point
+  //! @param[in,out] steps - step array as a point
+  //! @return        the dimension of the arrays after condensing, values at or
+  //!                after n in the arrays are junk
+  //!
+  //! Is used when applying operations on arrays to effectively reduce the
+  //! dimensionality of the data which will reduce loops and function calls.
+  //! Condensing the dim and step arrays from an aligned and continuous NArray
+  //! should result in return=1, sizes=size(sizes), steps={1}
+  //! Dimension array should all be positive and non-zero and step arrays must 
+  //! be valid to produce a meaningful result
+  template <std::size_t N>
+  constexpr std::size_t condense(Point<N>& sizes, Point<N>& steps) noexcept
+  {
+    std::size_t j = N-1;
+    for (std::size_t i = N-1; i > 0; --i)
+    {
+      if (steps[j] * sizes[j] == steps[i-1])
+      {
+        sizes[j] *= sizes[i-1];
+      }
+      else
+      {
+        --j;
+        sizes[j] = sizes[i-1];
+        steps[j] = steps[i-1];
+      }
+    }
+    for (std::size_t i = 0; i < j; ++i)
+    {
+      sizes[i] = 1;
+      steps[i] = absolute(sizes[j] * steps[j]);
+    }
+
+    return N - j;
+  }
+
+  //! @brief         Condenses a dim array and step arrays into smaller arrays
+  //!                if able to
+  //! @param[in,out] sizes - dimension array as a point
+  //! @param[in,out] step1 - step array as a point
+  //! @param[in,out] step2 - step array as a point that relates to another
+  //!                NArray of the same dimension array
+  //! @return        the dimension of the arrays after condensing, values at or
+  //!                after n in the arrays are junk
+  //!
+  //! Is used when applying operations on arrays to effectively reduce the
+  //! dimensionality of the data which will reduce loops and function calls.
+  //! Dimensions are only merged if they can be merged for both step arrays, a
+  //! pair of zero-step (repeated) dimensions can always be merged.
+  //! Condensing the dim and step arrays from two aligned and continuous NArrays
+  //! should result in return=1, sizes=size(sizes), step1={1}, step2={1}
+  //! Dimension array should all be positive and non-zero and step arrays must 
+  //! be valid to produce a meaningful result
+  template <std::size_t N>
+  constexpr std::size_t condense(Point<N>& sizes, Point<N>& step1, Point<N>& step2) noexcept
+  {
+    std::size_t j = N-1;
+    for (std::size_t i = N-1; i > 0; --i)
+    {
+      if (step1[j] * sizes[j] == step1[i-1] && step2[j] * sizes[j] == step2[i-1])
+      {
+        sizes[j] *= sizes[i-1];
+      }
+      else
+      {
+        --j;
+        sizes[j] = sizes[i-1];
+        step1[j] = step1[i-1];
+        step2[j] = step2[i-1];
+      }
+    }
+    for (std::size_t i = 0; i < j; ++i)
+    {
+      sizes[i] = 1;
+      step1[i] = absolute(sizes[j] * step1[j]);
+      step2[i] = absolute(sizes[j] * step2[j]);
+    }
+
+    return N - j;
+  }
+
+  //! @brief         Condenses a dim array and step arrays into smaller arrays
+  //!                if able to
+  //! @param[in,out] sizes - dimension array as a point
+  //! @param[in,out] step1 - step array as a point
+  //! @param[in,out] step2 - step array as a point that relates to another
+  //!                NArray of the same dimension array
+  //! @param[in,out] step3 - step array as a point that relates to another
+  //!                NArray of the same dimension array
+  //! @return        the dimension of the arrays after condensing, values at or
+  //!                after n in the arrays are junk
+  //!
+  //! Same as above but for three arrays
+  template <std::size_t N>
+  constexpr std::size_t condense(Point<N>& sizes, Point<N>& step1, Point<N>& step2, Point<N>& step3) noexcept
+  {
+    std::size_t j = N-1;
+    for (std::size_t i = N-1; i > 0; --i)
+    {
+      if (step1[j] * sizes[j] == step1[i-1] && step2[j] * sizes[j] == step2[i-1] && step3[j] * sizes[j] == step3[i-1])
+      {
+        sizes[j] *= sizes[i-1];
+      }
+      else
+      {
+        --j;
+        sizes[j] = sizes[i-1];
+        step1[j] = step1[i-1];
+        step2[j] = step2[i-1];
+        step3[j] = step3[i-1];
+      }
+    }
+    for (std::size_t i = 0; i < j; ++i)
+    {
+      sizes[i] = 1;
+      step1[i] = absolute(sizes[j] * step1[j]);
+      step2[i] = absolute(sizes[j] * step2[j]);
+      step3[i] = absolute(sizes[j] * step3[j]);
+    }
+
+    return N - j;
+  }
+
+  // Determines if an operand with a zero step along the innermost loop can be
+  // loaded once before the loop instead of on every iteration. This is only
+  // done for read-only, trivially-copyable elements that don't overlap the
+  // range of the first operand (which may be written to).
+  //
+  // Notes:
+  // - hoisted operands are passed to the functor as a local copy, which lets
+  //   the compiler treat them as a scalar when vectorizing the loop
+
+  template <class T>
+  struct is_hoistable : std::integral_constant<bool, std::is_const<T>::value && std::is_trivially_copyable<T>::value> { };
+
+  template <class T, class U>
+  bool canHoist(pos_t size, const T* data, pos_t step, const U* elem, pos_t elemstep) noexcept
+  {
+    if (!is_hoistable<U>::value || elemstep != 0 || size < 2)
+      return false;
+
+    auto first = reinterpret_cast<const char*>(data);
+    auto last = reinterpret_cast<const char*>(data + (size - 1) * step);
+    if (last < first)
+      std::swap(first, last);
+    last += sizeof(T);
+
+    auto elemfirst = reinterpret_cast<const char*>(elem);
+    auto elemlast = elemfirst + sizeof(U);
+
+    return elemlast <= first || last <= elemfirst;
+  }
+
   // Calls a functor on all corresponding elements from three arrays that are
   // accessed by their provided size and step pointers. 
   //
@@ -48,11 +222,16 @@ namespace detail
   // - the array sizes must all be the same (hence the single size parameter)
   // - this function makes no checks on the validity of the inputs
   // - the functor signature should be `void(T, U, V)` or similar
+  // - the arrays are condensed first and zero-step operands are hoisted out of
+  //   the innermost loop when possible
+
+  template <std::size_t N, class T, class U, class Functor>
+  struct binaryHelper;
 
   template <std::size_t N, class T, class U, class V, class Functor>
   struct ternaryHelper {
     static void call(const pos_t* sizes, T* data1, const pos_t* steps1, U* data2, const pos_t* steps2, V* data3, const pos_t* steps3, Functor& f) {
-      for (T* end = data1 + *sizes * *steps1; data1 != end; data1 += *steps1, data2 += *steps2, data3 += *steps3)
+      for (pos_t i = 0; i < *sizes; ++i, data1 += *steps1, data2 += *steps2, data3 += *steps3)
         ternaryHelper<N-1, T, U, V, Functor>::call(sizes + 1, data1, steps1 + 1, data2, steps2 + 1, data3, steps3 + 1, f);
     }
   };
@@ -60,15 +239,49 @@ namespace detail
   template <class T, class U, class V, class Functor>
   struct ternaryHelper<1u, T, U, V, Functor> {
     static void call(const pos_t* sizes, T* data1, const pos_t* steps1, U* data2, const pos_t* steps2, V* data3, const pos_t* steps3, Functor& f) {
-      for (T* end = data1 + *sizes * *steps1; data1 != end; data1 += *steps1, data2 += *steps2, data3 += *steps3)
-        f(*data1, *data2, *data3);
+      if (canHoist(*sizes, data1, *steps1, data3, *steps3))
+        hoist3(sizes, data1, steps1, data2, steps2, data3, f, is_hoistable<V>());
+      else if (canHoist(*sizes, data1, *steps1, data2, *steps2))
+        hoist2(sizes, data1, steps1, data2, data3, steps3, f, is_hoistable<U>());
+      else if (*steps1 == 1 && *steps2 == 1 && *steps3 == 1)
+        for (pos_t i = 0; i < *sizes; ++i)
+          f(data1[i], data2[i], data3[i]);
+      else
+        for (pos_t i = 0; i < *sizes; ++i, data1 += *steps1, data2 += *steps2, data3 += *steps3)
+          f(*data1, *data2, *data3);
     }
+
+    static void hoist3(const pos_t* sizes, T* data1, const pos_t* steps1, U* data2, const pos_t* steps2, V* data3, Functor& f, std::true_type) {
+      const typename std::remove_const<V>::type val = *data3;
+      auto g = [&f, &val](T& t, U& u) { f(t, u, val); };
+      binaryHelper<1u, T, U, decltype(g)>::call(sizes, data1, steps1, data2, steps2, g);
+    }
+
+    static void hoist2(const pos_t* sizes, T* data1, const pos_t* steps1, U* data2, V* data3, const pos_t* steps3, Functor& f, std::true_type) {
+      const typename std::remove_const<U>::type val = *data2;
+      auto g = [&f, &val](T& t, V& v) { f(t, val, v); };
+      binaryHelper<1u, T, V, decltype(g)>::call(sizes, data1, steps1, data3, steps3, g);
+    }
+
+    static void hoist3(const pos_t*, T*, const pos_t*, U*, const pos_t*, V*, Functor&, std::false_type) { }
+    static void hoist2(const pos_t*, T*, const pos_t*, U*, V*, const pos_t*, Functor&, std::false_type) { }
   };
 
   template <std::size_t N, class T, class U, class V, class Functor>
   void ternary(const pos_t* sizes, T* data1, const pos_t* steps1, U* data2, const pos_t* steps2, V* data3, const pos_t* steps3, Functor f)
   {
-    ternaryHelper<N, T, U, V, Functor>::call(sizes, data1, steps1, data2, steps2, data3, steps3, f);
+    Point<N> newsizes, newsteps1, newsteps2, newsteps3;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      newsizes[i] = sizes[i];
+      newsteps1[i] = steps1[i];
+      newsteps2[i] = steps2[i];
+      newsteps3[i] = steps3[i];
+    }
+    const std::size_t dims = condense(newsizes, newsteps1, newsteps2, newsteps3);
+    WILT_NARRAY_COUNT_KERNEL(dims);
+
+    ternaryHelper<N, T, U, V, Functor>::call(newsizes.data(), data1, newsteps1.data(), data2, newsteps2.data(), data3, newsteps3.data(), f);
   }
 
   // Calls a functor on all corresponding elements from two arrays that are
@@ -78,11 +291,13 @@ namespace detail
   // - the array sizes must all be the same (hence the single size parameter)
   // - this function makes no checks on the validity of the inputs
   // - the functor signature should be `void(T, U)` or similar
+  // - the arrays are condensed first and zero-step operands are hoisted out of
+  //   the innermost loop when possible
 
   template <std::size_t N, class T, class U, class Functor>
   struct binaryHelper {
     static void call(const pos_t* sizes, T* data1, const pos_t* steps1, U* data2, const pos_t* steps2, Functor& f) {
-      for (T* end = data1 + *sizes * *steps1; data1 != end; data1 += *steps1, data2 += *steps2)
+      for (pos_t i = 0; i < *sizes; ++i, data1 += *steps1, data2 += *steps2)
         binaryHelper<N-1, T, U, Functor>::call(sizes + 1, data1, steps1 + 1, data2, steps2 + 1, f);
     }
   };
@@ -90,15 +305,43 @@ namespace detail
   template <class T, class U, class Functor>
   struct binaryHelper<1u, T, U, Functor> {
     static void call(const pos_t* sizes, T* data1, const pos_t* steps1, U* data2, const pos_t* steps2, Functor& f) {
-      for (T* end = data1 + *sizes * *steps1; data1 != end; data1 += *steps1, data2 += *steps2)
-        f(*data1, *data2);
+      if (canHoist(*sizes, data1, *steps1, data2, *steps2))
+        hoist2(sizes, data1, steps1, data2, f, is_hoistable<U>());
+      else if (*steps1 == 1 && *steps2 == 1)
+        for (pos_t i = 0; i < *sizes; ++i)
+          f(data1[i], data2[i]);
+      else
+        for (pos_t i = 0; i < *sizes; ++i, data1 += *steps1, data2 += *steps2)
+          f(*data1, *data2);
     }
+
+    static void hoist2(const pos_t* sizes, T* data1, const pos_t* steps1, U* data2, Functor& f, std::true_type) {
+      const typename std::remove_const<U>::type val = *data2;
+      if (*steps1 == 1)
+        for (pos_t i = 0; i < *sizes; ++i)
+          f(data1[i], val);
+      else
+        for (pos_t i = 0; i < *sizes; ++i, data1 += *steps1)
+          f(*data1, val);
+    }
+
+    static void hoist2(const pos_t*, T*, const pos_t*, U*, Functor&, std::false_type) { }
   };
 
   template <std::size_t N, class T, class U, class Functor>
   void binary(const pos_t* sizes, T* data1, const pos_t* steps1, U* data2, const pos_t* steps2, Functor f)
   {
-    binaryHelper<N, T, U, Functor>::call(sizes, data1, steps1, data2, steps2, f);
+    Point<N> newsizes, newsteps1, newsteps2;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      newsizes[i] = sizes[i];
+      newsteps1[i] = steps1[i];
+      newsteps2[i] = steps2[i];
+    }
+    const std::size_t dims = condense(newsizes, newsteps1, newsteps2);
+    WILT_NARRAY_COUNT_KERNEL(dims);
+
+    binaryHelper<N, T, U, Functor>::call(newsizes.data(), data1, newsteps1.data(), data2, newsteps2.data(), f);
   }
 
   // Calls a functor on all elements from an array that is accessed by its
@@ -107,11 +350,12 @@ namespace detail
   // Notes:
   // - this function makes no checks on the validity of the inputs
   // - the functor signature should be `void(T)` or similar
+  // - the array is condensed first
 
   template <std::size_t N, class T, class Functor>
   struct unaryHelper {
     static void call(const pos_t* sizes, T* data, const pos_t* steps, Functor& f) {
-      for (T* end = data + *sizes * *steps; data != end; data += *steps)
+      for (pos_t i = 0; i < *sizes; ++i, data += *steps)
         unaryHelper<N-1, T, Functor>::call(sizes + 1, data, steps + 1, f);
     }
   };
@@ -119,15 +363,28 @@ namespace detail
   template <class T, class Functor>
   struct unaryHelper<1u, T, Functor> {
     static void call(const pos_t* sizes, T* data, const pos_t* steps, Functor& f) {
-      for (T* end = data + *sizes * *steps; data != end; data += *steps)
-        f(*data);
+      if (*steps == 1)
+        for (pos_t i = 0; i < *sizes; ++i)
+          f(data[i]);
+      else
+        for (pos_t i = 0; i < *sizes; ++i, data += *steps)
+          f(*data);
     }
   };
 
   template <std::size_t N, class T, class Functor>
   void unary(const pos_t* sizes, T* data, const pos_t* steps, Functor f)
   {
-    unaryHelper<N, T, Functor>::call(sizes, data, steps, f);
+    Point<N> newsizes, newsteps;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      newsizes[i] = sizes[i];
+      newsteps[i] = steps[i];
+    }
+    const std::size_t dims = condense(newsizes, newsteps);
+    WILT_NARRAY_COUNT_KERNEL(dims);
+
+    unaryHelper<N, T, Functor>::call(newsizes.data(), data, newsteps.data(), f);
   }
 
   // Calls a functor on corresponding elements from two arrays accessed by their
@@ -149,16 +406,15 @@ namespace detail
     Operator op, 
     std::size_t n)
   {
-    const T* end = src1 + sizes[0] * s1steps[0];
     if (n == 1)
     {
-      for (; src1 != end; src1 += s1steps[0], src2 += s2steps[0])
+      for (pos_t i = 0; i < sizes[0]; ++i, src1 += s1steps[0], src2 += s2steps[0])
         if (!op(src1[0], src2[0]))
           return false;
     }
     else
     {
-      for (; src1 != end; src1 += s1steps[0], src2 += s2steps[0])
+      for (pos_t i = 0; i < sizes[0]; ++i, src1 += s1steps[0], src2 += s2steps[0])
         if (!allOf(src1, src2, sizes + 1, s1steps + 1, s2steps + 1, op, n - 1))
           return false;
     }
@@ -180,22 +436,40 @@ namespace detail
     Operator op,
     std::size_t n)
   {
-    const T* end = src + sizes[0] * ssteps[0];
     if (n == 1)
     {
-      for (; src != end; src += ssteps[0])
+      for (pos_t i = 0; i < sizes[0]; ++i, src += ssteps[0])
         if (!op(src[0]))
           return false;
     }
     else
     {
-      for (; src != end; src += ssteps[0])
+      for (pos_t i = 0; i < sizes[0]; ++i, src += ssteps[0])
         if (!allOf(src, sizes + 1, ssteps + 1, op, n - 1))
           return false;
     }
     return true;
   }
 
+  // Gets the offset of the nth element of an array accessed by the provided
+  // size and step points, counting elements in order.
+  //
+  // Notes:
+  // - this function makes no checks on the validity of the inputs
+  // - is used for splitting arrays into lanes along a dimension by calling it
+  //   with the sizes and steps with that dimension removed
+  template <std::size_t N>
+  pos_t offsetOf(pos_t n, const Point<N>& sizes, const Point<N>& steps) noexcept
+  {
+    pos_t offset = 0;
+    for (std::size_t i = N; i > 0; --i)
+    {
+      offset += (n % sizes[i-1]) * steps[i-1];
+      n /= sizes[i-1];
+    }
+    return offset;
+  }
+
   // The `narray_source_traits` class determines what types are available for
   // `make_narray` calls and uses static functions to get the required
   // information needed to build the array.
@@ -0,0 +1,537 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: algorithmtests.cpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Tests for the NArray algorithms
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "../src/wilt-narray/algorithms.hpp"
+
+namespace
+{
+  int counter = 0;
+  int next() { return ++counter % 7; }
+}
+
+TEST_CASE("inclusiveScan(arr, dim) computes running sums along each dimension")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 3, 4, 5 }, next);
+
+  // act
+  auto x = wilt::inclusiveScan(a, 0);
+  auto y = wilt::inclusiveScan(a, 1);
+  auto z = wilt::inclusiveScan(a, 2);
+
+  // assert
+  REQUIRE(x.sizes() == a.sizes());
+  REQUIRE(y.sizes() == a.sizes());
+  REQUIRE(z.sizes() == a.sizes());
+  for (wilt::pos_t i = 0; i < 3; ++i)
+    for (wilt::pos_t j = 0; j < 4; ++j)
+      for (wilt::pos_t k = 0; k < 5; ++k)
+      {
+        int sx = 0, sy = 0, sz = 0;
+        for (wilt::pos_t n = 0; n <= i; ++n) sx += a.at(n, j, k);
+        for (wilt::pos_t n = 0; n <= j; ++n) sy += a.at(i, n, k);
+        for (wilt::pos_t n = 0; n <= k; ++n) sz += a.at(i, j, n);
+        REQUIRE(x.at(i, j, k) == sx);
+        REQUIRE(y.at(i, j, k) == sy);
+        REQUIRE(z.at(i, j, k) == sz);
+      }
+}
+
+TEST_CASE("inclusiveScan(arr, dim) works on transformed arrays")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 4, 6 }, next);
+  wilt::NArray<int, 2> t = a.transpose().flipY();
+
+  // act
+  auto b = wilt::inclusiveScan(t, 1);
+
+  // assert
+  REQUIRE(b.sizes() == wilt::Point<2>(6, 4));
+  for (wilt::pos_t i = 0; i < 6; ++i)
+  {
+    int sum = 0;
+    for (wilt::pos_t j = 0; j < 4; ++j)
+    {
+      sum += t.at(i, j);
+      REQUIRE(b.at(i, j) == sum);
+    }
+  }
+}
+
+TEST_CASE("inclusiveScan(arr, dim, op) uses the provided operation")
+{
+  // arrange
+  wilt::NArray<int, 1> a({ 6 }, { 3, 1, 4, 1, 5, 9 });
+
+  // act
+  auto b = wilt::inclusiveScan(a, 0, [](int l, int r) { return std::max(l, r); });
+
+  // assert
+  REQUIRE(b.at(0) == 3);
+  REQUIRE(b.at(1) == 3);
+  REQUIRE(b.at(2) == 4);
+  REQUIRE(b.at(3) == 4);
+  REQUIRE(b.at(4) == 5);
+  REQUIRE(b.at(5) == 9);
+}
+
+TEST_CASE("inclusiveScan(arr, dim) can scan a long single lane")
+{
+  // arrange
+  wilt::NArray<long long, 1> a({ 300000 }, 1ll);
+
+  // act
+  auto b = wilt::inclusiveScan(a, 0);
+
+  // assert
+  REQUIRE(b.at(0) == 1);
+  REQUIRE(b.at(150000) == 150001);
+  REQUIRE(b.at(299999) == 300000);
+}
+
+TEST_CASE("inclusiveScan(arr, dim) throws if dimension is larger than N")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 });
+
+  // assert
+  REQUIRE_THROWS(wilt::inclusiveScan(a, 2));
+}
+
+TEST_CASE("inclusiveScan(arr, dim) creates an empty array when called on an empty array")
+{
+  // arrange
+  wilt::NArray<int, 2> a;
+
+  // act
+  auto b = wilt::inclusiveScan(a, 0);
+
+  // assert
+  REQUIRE(b.empty());
+}
+
+TEST_CASE("exclusiveScan(arr, dim, init) computes running sums before each element")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 }, { 1, 2, 3, 4, 5, 6 });
+
+  // act
+  auto x = wilt::exclusiveScan(a, 0, 10);
+  auto y = wilt::exclusiveScan(a, 1);
+
+  // assert
+  REQUIRE(x.at(0, 0) == 10);
+  REQUIRE(x.at(0, 2) == 10);
+  REQUIRE(x.at(1, 0) == 11);
+  REQUIRE(x.at(1, 2) == 13);
+  REQUIRE(y.at(0, 0) == 0);
+  REQUIRE(y.at(0, 1) == 1);
+  REQUIRE(y.at(0, 2) == 3);
+  REQUIRE(y.at(1, 0) == 0);
+  REQUIRE(y.at(1, 2) == 9);
+}
+
+TEST_CASE("exclusiveScan(arr, dim, init) can scan a long single lane")
+{
+  // arrange
+  wilt::NArray<long long, 1> a({ 300000 }, 2ll);
+
+  // act
+  auto b = wilt::exclusiveScan(a, 0, 5ll, std::plus<long long>());
+
+  // assert
+  REQUIRE(b.at(0) == 5);
+  REQUIRE(b.at(1) == 7);
+  REQUIRE(b.at(150000) == 300005);
+  REQUIRE(b.at(299999) == 600003);
+}
+
+TEST_CASE("sort(arr, dim) sorts each lane along the dimension")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 3, 4, 5 }, next);
+  wilt::NArray<int, 3> b = a.clone();
+
+  // act
+  wilt::sort(a, 1);
+
+  // assert
+  for (wilt::pos_t i = 0; i < 3; ++i)
+    for (wilt::pos_t k = 0; k < 5; ++k)
+    {
+      std::vector<int> expected;
+      for (wilt::pos_t j = 0; j < 4; ++j) expected.push_back(b.at(i, j, k));
+      std::sort(expected.begin(), expected.end());
+      for (wilt::pos_t j = 0; j < 4; ++j)
+        REQUIRE(a.at(i, j, k) == expected[j]);
+    }
+}
+
+TEST_CASE("sort(arr, dim) sorts long lanes of signed and floating point values")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 3, 1000 }, [](){ return (next() - 3) * 100003 % 2011; });
+  wilt::NArray<double, 2> b({ 1000, 3 }, [](){ return (next() - 3) * 0.25 - 1e-3 * next(); });
+  wilt::NArray<int, 2> ea = a.clone();
+  wilt::NArray<double, 2> eb = b.clone();
+
+  // act
+  wilt::sort(a, 1);
+  wilt::sort(b, 0);
+
+  // assert
+  for (wilt::pos_t i = 0; i < 3; ++i)
+  {
+    wilt::NArray<int, 1> la = ea.sliceX(i);
+    wilt::NArray<double, 1> lb = eb.sliceY(i);
+    std::vector<int> va(la.begin(), la.end());
+    std::vector<double> vb(lb.begin(), lb.end());
+    std::sort(va.begin(), va.end());
+    std::sort(vb.begin(), vb.end());
+    for (wilt::pos_t j = 0; j < 1000; ++j)
+    {
+      REQUIRE(a.at(i, j) == va[j]);
+      REQUIRE(b.at(j, i) == vb[j]);
+    }
+  }
+}
+
+TEST_CASE("sort(arr, dim, comp) uses the provided comparison")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 4, 6 }, next);
+  wilt::NArray<int, 2> t = a.transpose();
+
+  // act
+  wilt::sort(t, 1, std::greater<int>());
+
+  // assert
+  for (wilt::pos_t i = 0; i < 6; ++i)
+    for (wilt::pos_t j = 1; j < 4; ++j)
+      REQUIRE(a.at(j - 1, i) >= a.at(j, i));
+}
+
+TEST_CASE("sort(arr, dim) throws if dimension is larger than N")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 });
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::sort(a, 2), std::out_of_range);
+}
+
+TEST_CASE("argsort(arr, dim) gets the stable sorted order of each lane")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 4, 9 }, next);
+  wilt::NArray<const int, 2> c = a;
+
+  // act
+  wilt::NArray<wilt::pos_t, 2> x = wilt::argsort(c, 0);
+  wilt::NArray<wilt::pos_t, 2> y = wilt::argsort(c, 1);
+
+  // assert
+  REQUIRE(x.sizes() == a.sizes());
+  REQUIRE(y.sizes() == a.sizes());
+  for (wilt::pos_t i = 0; i < 4; ++i)
+    for (wilt::pos_t j = 1; j < 9; ++j)
+    {
+      wilt::pos_t p = y.at(i, j - 1), q = y.at(i, j);
+      REQUIRE((a.at(i, p) < a.at(i, q) || (a.at(i, p) == a.at(i, q) && p < q)));
+    }
+  for (wilt::pos_t j = 0; j < 9; ++j)
+    for (wilt::pos_t i = 1; i < 4; ++i)
+    {
+      wilt::pos_t p = x.at(i - 1, j), q = x.at(i, j);
+      REQUIRE((a.at(p, j) < a.at(q, j) || (a.at(p, j) == a.at(q, j) && p < q)));
+    }
+}
+
+TEST_CASE("argsort(arr, dim) gets the stable sorted order of long lanes")
+{
+  // arrange
+  wilt::NArray<float, 2> a({ 2, 700 }, [](){ return (next() - 3) * 0.5f; });
+
+  // act
+  wilt::NArray<wilt::pos_t, 2> b = wilt::argsort(a, 1);
+
+  // assert
+  for (wilt::pos_t i = 0; i < 2; ++i)
+    for (wilt::pos_t j = 1; j < 700; ++j)
+    {
+      wilt::pos_t p = b.at(i, j - 1), q = b.at(i, j);
+      REQUIRE((a.at(i, p) < a.at(i, q) || (a.at(i, p) == a.at(i, q) && p < q)));
+    }
+}
+
+TEST_CASE("argsort(arr, dim) keeps -0.0 and 0.0 in order regardless of lane length")
+{
+  // arrange
+  wilt::NArray<double, 1> a(wilt::Point<1>{ 300 });
+  for (wilt::pos_t i = 0; i < 300; ++i)
+    a.at(i) = (i % 2) ? 0.0 : -0.0;
+
+  // act
+  wilt::NArray<wilt::pos_t, 1> b = wilt::argsort(a, 0);
+  wilt::NArray<wilt::pos_t, 1> c = wilt::argsort(a.rangeX(0, 10), 0);
+
+  // assert
+  for (wilt::pos_t i = 0; i < 300; ++i)
+    REQUIRE(b.at(i) == i);
+  for (wilt::pos_t i = 0; i < 10; ++i)
+    REQUIRE(c.at(i) == i);
+}
+
+TEST_CASE("argsort(arr, dim, comp) uses the provided comparison")
+{
+  // arrange
+  wilt::NArray<int, 1> a({ 5 }, next);
+
+  // act
+  wilt::NArray<wilt::pos_t, 1> b = wilt::argsort(a, 0, std::greater<int>());
+
+  // assert
+  for (wilt::pos_t i = 1; i < 5; ++i)
+    REQUIRE(a.at(b.at(i - 1)) >= a.at(b.at(i)));
+}
+
+TEST_CASE("argsort(arr, dim) creates an empty array when called on an empty array")
+{
+  // arrange
+  wilt::NArray<int, 2> a;
+
+  // act
+  auto b = wilt::argsort(a, 1);
+
+  // assert
+  REQUIRE(b.empty());
+}
+
+TEST_CASE("nthElement(arr, dim, k) gets the kth smallest element of each lane")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 5, 40 }, [](){ return next() * 37 % 101; });
+  wilt::NArray<int, 2> sorted = a.clone();
+  wilt::sort(sorted, 1);
+
+  // act & assert
+  for (wilt::pos_t k : { 0, 3, 20, 36, 39 })
+  {
+    wilt::NArray<int, 2> b = wilt::nthElement(a, 1, k);
+    REQUIRE(b.sizes() == wilt::Point<2>(5, 1));
+    for (wilt::pos_t i = 0; i < 5; ++i)
+      REQUIRE(b.at(i, 0) == sorted.at(i, k));
+  }
+}
+
+TEST_CASE("nthElement(arr, dim, k) does not modify the source")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 30, 3 }, next);
+  wilt::NArray<int, 2> b = a.clone();
+
+  // act
+  wilt::nthElement(a, 0, 17);
+
+  // assert
+  REQUIRE(std::equal(a.begin(), a.end(), b.begin()));
+}
+
+TEST_CASE("nthElement(arr, dim, k) throws if k is out of bounds")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 });
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::nthElement(a, 1, 3), std::out_of_range);
+  REQUIRE_THROWS_AS(wilt::nthElement(a, 1, -1), std::out_of_range);
+  REQUIRE_THROWS_AS(wilt::nthElement(a, 2, 0), std::out_of_range);
+}
+
+TEST_CASE("topK(arr, dim, k) gets the largest elements and their positions")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 60, 3 }, next);
+
+  for (wilt::pos_t k : { 1, 5, 40, 60 })
+  {
+    // act
+    auto b = wilt::topK(a, 0, k);
+
+    // assert
+    REQUIRE(b.first.sizes() == wilt::Point<2>(k, 3));
+    REQUIRE(b.second.sizes() == wilt::Point<2>(k, 3));
+    for (wilt::pos_t j = 0; j < 3; ++j)
+    {
+      std::vector<std::pair<int, wilt::pos_t>> expected;
+      for (wilt::pos_t i = 0; i < 60; ++i)
+        expected.emplace_back(-a.at(i, j), i);
+      std::sort(expected.begin(), expected.end());
+      for (wilt::pos_t i = 0; i < k; ++i)
+      {
+        REQUIRE(b.first.at(i, j) == -expected[i].first);
+        REQUIRE(b.second.at(i, j) == expected[i].second);
+      }
+    }
+  }
+}
+
+TEST_CASE("median(arr, dim) gets the median of each lane")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 3, 2, 2 }, { 5, 1, 2, 8, 3, 9, 4, 7, 1, 4, 6, 6 });
+
+  // act
+  wilt::NArray<int, 3> b = wilt::median(a, 0);
+  wilt::NArray<int, 3> c = wilt::median(a, 2);
+
+  // assert
+  REQUIRE(b.sizes() == wilt::Point<3>(1, 2, 2));
+  REQUIRE(b.at(0, 0, 0) == 3);
+  REQUIRE(b.at(0, 0, 1) == 4);
+  REQUIRE(b.at(0, 1, 0) == 4);
+  REQUIRE(b.at(0, 1, 1) == 7);
+  REQUIRE(c.sizes() == wilt::Point<3>(3, 2, 1));
+  REQUIRE(c.at(0, 0, 0) == 1);
+  REQUIRE(c.at(1, 1, 0) == 4);
+}
+
+TEST_CASE("histogram(arr, bins, lo, hi) counts elements in equal width bins")
+{
+  // arrange
+  wilt::NArray<float, 2> a({ 2, 5 }, { -1.0f, 0.0f, 0.5f, 1.9f, 2.0f, 3.5f, 4.0f, 4.5f, NAN, 2.5f });
+
+  // act
+  wilt::NArray<std::size_t, 1> b = wilt::histogram(a, 4, 0.0, 4.0);
+
+  // assert
+  REQUIRE(b.sizes() == wilt::Point<1>(4));
+  REQUIRE(b.at(0) == 2);
+  REQUIRE(b.at(1) == 1);
+  REQUIRE(b.at(2) == 2);
+  REQUIRE(b.at(3) == 2);
+}
+
+TEST_CASE("histogram(arr, bins, lo, hi) counts large transformed arrays")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 40, 30, 50 }, next);
+  wilt::NArray<int, 3> t = a.transpose(0, 2).flipY();
+
+  // act
+  wilt::NArray<std::size_t, 1> b = wilt::histogram(t, 7, 0.0, 7.0);
+
+  // assert
+  std::size_t expected[7] = { };
+  for (int v : a) ++expected[v];
+  for (wilt::pos_t i = 0; i < 7; ++i)
+    REQUIRE(b.at(i) == expected[i]);
+}
+
+TEST_CASE("histogram(arr, bins, lo, hi) throws on invalid bins or range")
+{
+  // arrange
+  wilt::NArray<int, 1> a(wilt::Point<1>{ 3 }, 0);
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::histogram(a, 0, 0.0, 1.0), std::invalid_argument);
+  REQUIRE_THROWS_AS(wilt::histogram(a, 2, 1.0, 1.0), std::invalid_argument);
+}
+
+TEST_CASE("histogram(arr, dim, bins, lo, hi) counts each lane along the dimension")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 6, 3, 4 }, next);
+
+  // act
+  wilt::NArray<std::size_t, 3> b = wilt::histogram(a, 0, 7, 0.0, 7.0);
+
+  // assert
+  REQUIRE(b.sizes() == wilt::Point<3>(7, 3, 4));
+  for (wilt::pos_t j = 0; j < 3; ++j)
+    for (wilt::pos_t k = 0; k < 4; ++k)
+    {
+      std::size_t expected[7] = { };
+      for (wilt::pos_t i = 0; i < 6; ++i) ++expected[a.at(i, j, k)];
+      for (wilt::pos_t i = 0; i < 7; ++i)
+        REQUIRE(b.at(i, j, k) == expected[i]);
+    }
+}
+
+TEST_CASE("bincount(arr) counts the occurrences of each value")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 300, 200 }, next);
+  wilt::NArray<int, 2> b({ 2, 3 }, { 0, 4, 4, 1, 4, 0 });
+
+  // act
+  wilt::NArray<std::size_t, 1> x = wilt::bincount(a.transpose());
+  wilt::NArray<std::size_t, 1> y = wilt::bincount(b);
+
+  // assert
+  std::size_t expected[7] = { };
+  for (int v : a) ++expected[v];
+  REQUIRE(x.sizes() == wilt::Point<1>(7));
+  for (wilt::pos_t i = 0; i < 7; ++i)
+    REQUIRE(x.at(i) == expected[i]);
+  REQUIRE(y.sizes() == wilt::Point<1>(5));
+  REQUIRE(y.at(0) == 2);
+  REQUIRE(y.at(1) == 1);
+  REQUIRE(y.at(2) == 0);
+  REQUIRE(y.at(3) == 0);
+  REQUIRE(y.at(4) == 3);
+}
+
+TEST_CASE("bincount(arr) throws on negative values")
+{
+  // arrange
+  wilt::NArray<int, 1> a({ 3 }, { 1, -2, 3 });
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::bincount(a), std::domain_error);
+}
+
+TEST_CASE("bincount(arr) throws on values too large to count")
+{
+  // arrange
+  wilt::NArray<std::uint64_t, 1> a({ 2 }, { 1, std::uint64_t(1) << 63 });
+  wilt::NArray<std::int64_t, 1> b({ 2 }, { 1, std::numeric_limits<std::int64_t>::max() });
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::bincount(a), std::invalid_argument);
+  REQUIRE_THROWS_AS(wilt::bincount(b), std::invalid_argument);
+}
@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: bitmasktests.cpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Tests for the BitMask class
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+
+#include "../src/wilt-narray/narray.hpp"
+
+namespace
+{
+  int counter = 0;
+  int next() { return ++counter % 7; }
+}
+
+TEST_CASE("BitMask(size, val) creates a mask with every element set to val")
+{
+  // arrange & act
+  wilt::BitMask<2> a({ 3, 50 }, true);
+  wilt::BitMask<2> b({ 3, 50 });
+
+  // assert
+  REQUIRE(a.sizes() == wilt::Point<2>(3, 50));
+  REQUIRE(a.size() == 150);
+  REQUIRE(a.wordCount() == 3);
+  REQUIRE(a.count() == 150);
+  REQUIRE(b.count() == 0);
+  REQUIRE(a.at({ 2, 49 }));
+  REQUIRE(!b.at({ 2, 49 }));
+}
+
+TEST_CASE("BitMask(mask) packs a boolean array in order")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 5, 7, 9 }, next);
+  wilt::NArray<int, 3> t = a.transpose(0, 2).flipY();
+  wilt::NArray<bool, 3> m = wilt::compareGT(t, 3);
+
+  // act
+  wilt::BitMask<3> b(m);
+
+  // assert
+  REQUIRE(b.sizes() == m.sizes());
+  wilt::pos_t n = 0;
+  wilt::pos_t count = 0;
+  for (bool v : m)
+  {
+    REQUIRE(b.test(n++) == v);
+    count += v ? 1 : 0;
+  }
+  REQUIRE(b.count() == count);
+}
+
+TEST_CASE("BitMask(arr, pred) packs the results of the predicate")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 30, 40 }, next);
+
+  // act
+  wilt::BitMask<2> b(a, [](int v) { return v == 2; });
+
+  // assert
+  for (wilt::pos_t i = 0; i < 30; ++i)
+    for (wilt::pos_t j = 0; j < 40; ++j)
+      REQUIRE(b.at({ i, j }) == (a.at(i, j) == 2));
+}
+
+TEST_CASE("BitMask toNArray() unpacks the mask")
+{
+  // arrange
+  wilt::NArray<bool, 2> m({ 2, 3 }, { true, false, true, false, false, true });
+  wilt::BitMask<2> b(m);
+
+  // act
+  wilt::NArray<bool, 2> c = b.toNArray();
+
+  // assert
+  REQUIRE(c.sizes() == m.sizes());
+  REQUIRE(std::equal(c.begin(), c.end(), m.begin()));
+}
+
+TEST_CASE("BitMask set(loc, val) changes a single element")
+{
+  // arrange
+  wilt::BitMask<2> b({ 4, 20 });
+
+  // act
+  b.set({ 3, 5 }, true);
+  b.set({ 1, 2 }, true);
+  b.set({ 1, 2 }, false);
+
+  // assert
+  REQUIRE(b.count() == 1);
+  REQUIRE(b.at({ 3, 5 }));
+  REQUIRE_THROWS_AS(b.set({ 4, 0 }, true), std::out_of_range);
+}
+
+TEST_CASE("BitMask logical operators work element-wise")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 11, 13 }, next);
+  wilt::BitMask<2> x(a, [](int v) { return v % 2 == 0; });
+  wilt::BitMask<2> y(a, [](int v) { return v > 2; });
+
+  // act
+  wilt::BitMask<2> band = x & y;
+  wilt::BitMask<2> bor = x | y;
+  wilt::BitMask<2> bxor = x ^ y;
+  wilt::BitMask<2> bnot = ~x;
+
+  // assert
+  for (wilt::pos_t n = 0; n < 143; ++n)
+  {
+    REQUIRE(band.test(n) == (x.test(n) && y.test(n)));
+    REQUIRE(bor.test(n) == (x.test(n) || y.test(n)));
+    REQUIRE(bxor.test(n) == (x.test(n) != y.test(n)));
+    REQUIRE(bnot.test(n) == !x.test(n));
+  }
+  REQUIRE(bnot.count() == 143 - x.count());
+}
+
+TEST_CASE("BitMask logical operators throw if the sizes don't match")
+{
+  // arrange
+  wilt::BitMask<2> x({ 2, 3 });
+  wilt::BitMask<2> y({ 3, 2 });
+
+  // act & assert
+  REQUIRE_THROWS_AS(x & y, std::invalid_argument);
+  REQUIRE_THROWS_AS(x |= y, std::invalid_argument);
+}
+
+TEST_CASE("setTo(val, mask) sets the elements where the bit mask is set")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 6, 70, 5 }, next);
+  wilt::NArray<int, 3> t = a.transpose(1, 2).flipX();
+  wilt::NArray<int, 3> e = t.clone();
+  wilt::NArray<bool, 3> m = wilt::compareLT(t, 3);
+
+  // act
+  t.setTo(-1, wilt::BitMask<3>(m));
+  e.setTo(-1, m);
+
+  // assert
+  REQUIRE(std::equal(t.begin(), t.end(), e.begin()));
+}
+
+TEST_CASE("setTo(arr, mask) copies the elements where the bit mask is set")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 9, 100 }, 0);
+  wilt::NArray<int, 2> b({ 100, 9 }, next);
+  wilt::NArray<int, 2> e({ 9, 100 }, 0);
+  wilt::NArray<bool, 2> m = wilt::compareEQ(b.transpose(), 4);
+
+  // act
+  a.setTo(b.transpose(), wilt::BitMask<2>(m));
+  e.setTo(b.transpose(), m);
+
+  // assert
+  REQUIRE(std::equal(a.begin(), a.end(), e.begin()));
+}
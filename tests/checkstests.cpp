@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: checkstests.cpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Tests for the WILT_NARRAY_CHECKS policy macros
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define WILT_NARRAY_CHECKS none
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+
+// only the policy macros are tested here, the library headers are not included
+// since the policy must be the same in every translation unit of a program
+#include "../src/wilt-narray/checks.hpp"
+
+namespace
+{
+  int calls = 0;
+
+  bool invalid()
+  {
+    ++calls;
+    return false;
+  }
+}
+
+TEST_CASE("WILT_NARRAY_CHECKS=none selects the unchecked policy")
+{
+  REQUIRE(WILT_NARRAY_CHECKS_POLICY(WILT_NARRAY_CHECKS) == WILT_NARRAY_CHECKS_none);
+  REQUIRE(WILT_NARRAY_CHECKS_POLICY(throw) == WILT_NARRAY_CHECKS_throw);
+  REQUIRE(WILT_NARRAY_CHECKS_POLICY(assert) == WILT_NARRAY_CHECKS_assert);
+}
+
+TEST_CASE("WILT_NARRAY_CHECKS=none doesn't evaluate or act on the condition")
+{
+  // arrange
+  calls = 0;
+
+  // act & assert
+  REQUIRE_NOTHROW(WILT_NARRAY_CHECK(invalid(), std::out_of_range, "check(): not valid"));
+  REQUIRE(calls == 0);
+}
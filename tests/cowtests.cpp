@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: cowtests.cpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Tests for the CowNArray class
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+
+#include "../src/wilt-narray/cow.hpp"
+
+TEST_CASE("CowNArray writes in place when the data is not shared")
+{
+  // arrange
+  wilt::CowNArray<int, 2> a({ 3, 4 }, 1);
+  const int* before = a.view().data();
+
+  // act
+  a.at({ 1, 2 }) = 5;
+  a += 1;
+  a.setTo(7);
+
+  // assert
+  REQUIRE(!a.shared());
+  REQUIRE(a.view().data() == before);
+  REQUIRE(a.at({ 1, 2 }) == 7);
+}
+
+TEST_CASE("CowNArray copies shared data before writing")
+{
+  // arrange
+  wilt::CowNArray<int, 2> a({ 3, 4 }, 1);
+  wilt::CowNArray<int, 2> b = a;
+
+  // act
+  REQUIRE(a.shared());
+  REQUIRE(b.view().data() == a.view().data());
+  b.at({ 0, 0 }) = 9;
+  b *= 2;
+
+  // assert
+  REQUIRE(b.view().data() != a.view().data());
+  REQUIRE(!a.shared());
+  REQUIRE(!b.shared());
+  REQUIRE(a.view().at(0, 0) == 1);
+  REQUIRE(a.view().at(2, 3) == 1);
+  REQUIRE(b.view().at(0, 0) == 18);
+  REQUIRE(b.view().at(2, 3) == 2);
+}
+
+TEST_CASE("CowNArray does not copy for reads or views")
+{
+  // arrange
+  const wilt::CowNArray<int, 1> a(wilt::Point<1>{ 5 }, 3);
+  wilt::CowNArray<int, 1> b = a;
+
+  // act
+  int x = a.at({ 4 });
+  wilt::NArray<const int, 1> v = b.view();
+
+  // assert
+  REQUIRE(x == 3);
+  REQUIRE(v.data() == a.view().data());
+}
+
+TEST_CASE("CowNArray made from an NArray leaves the original unchanged")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 10, 10 }, 4);
+  wilt::CowNArray<int, 2> b(a.subarray({ 2, 2 }, { 3, 3 }));
+
+  // act
+  b -= 1;
+  b += b.view();
+
+  // assert
+  REQUIRE(a.unique());
+  REQUIRE(b.sizes() == wilt::Point<2>(3, 3));
+  REQUIRE(b.view().isContiguous());
+  REQUIRE(b.view().at(0, 0) == 6);
+  REQUIRE(a.at(2, 2) == 4);
+}
+
+TEST_CASE("CowNArray checks before copying")
+{
+  // arrange
+  wilt::CowNArray<int, 2> a({ 3, 4 }, 1);
+  wilt::CowNArray<int, 2> b = a;
+
+  // act & assert
+  REQUIRE_THROWS_AS(b.at({ 3, 0 }), std::out_of_range);
+  REQUIRE_THROWS_AS(b.setTo(wilt::NArray<int, 2>({ 4, 3 })), std::invalid_argument);
+  REQUIRE(b.shared());
+}
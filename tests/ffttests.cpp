@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: ffttests.cpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Tests for the NArray Fourier transform functions
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "../src/wilt-narray/fft.hpp"
+
+namespace
+{
+  int counter = 0;
+  double next() { return (++counter % 13) - 6.0; }
+
+  std::complex<double> nextComplex() { double re = next(); return std::complex<double>(re, next()); }
+
+  template <class T>
+  std::vector<std::complex<double>> naiveDft(const wilt::NArray<T, 1>& arr)
+  {
+    const double pi = 3.14159265358979323846;
+    const wilt::pos_t n = arr.sizes()[0];
+    std::vector<std::complex<double>> ret(n);
+    for (wilt::pos_t k = 0; k < n; ++k)
+      for (wilt::pos_t j = 0; j < n; ++j)
+        ret[k] += std::complex<double>(arr.at(j)) * std::polar(1.0, -2.0 * pi * double(j * k) / double(n));
+    return ret;
+  }
+}
+
+TEST_CASE("fft(arr, dim) matches the discrete Fourier transform for many lengths")
+{
+  for (wilt::pos_t n : { 1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 16, 25, 30, 64, 97, 100, 128 })
+  {
+    // arrange
+    wilt::NArray<std::complex<double>, 1> a({ n }, nextComplex);
+
+    // act
+    wilt::NArray<std::complex<double>, 1> b = wilt::fft(a, 0);
+
+    // assert
+    std::vector<std::complex<double>> expected = naiveDft(a);
+    REQUIRE(b.sizes() == a.sizes());
+    for (wilt::pos_t k = 0; k < n; ++k)
+    {
+      REQUIRE(b.at(k).real() == Approx(expected[k].real()).margin(1e-9));
+      REQUIRE(b.at(k).imag() == Approx(expected[k].imag()).margin(1e-9));
+    }
+  }
+}
+
+TEST_CASE("fft(arr, dim) transforms each lane of strided dimensions")
+{
+  // arrange
+  wilt::NArray<std::complex<float>, 3> a({ 6, 10, 3 }, []() { return std::complex<float>(float(next()), float(next())); });
+  wilt::NArray<std::complex<float>, 3> t = a.transpose(0, 2);
+
+  // act
+  wilt::NArray<std::complex<float>, 3> b = wilt::fft(t, 2);
+
+  // assert
+  REQUIRE(b.sizes() == wilt::Point<3>(3, 10, 6));
+  for (wilt::pos_t i = 0; i < 3; ++i)
+    for (wilt::pos_t j = 0; j < 10; ++j)
+    {
+      std::vector<std::complex<double>> expected = naiveDft(t.sliceX(i).sliceX(j));
+      for (wilt::pos_t k = 0; k < 6; ++k)
+      {
+        REQUIRE(b.at(i, j, k).real() == Approx(expected[k].real()).margin(1e-4));
+        REQUIRE(b.at(i, j, k).imag() == Approx(expected[k].imag()).margin(1e-4));
+      }
+    }
+}
+
+TEST_CASE("ifft(arr, dim) inverts fft(arr, dim)")
+{
+  // arrange
+  wilt::NArray<std::complex<double>, 2> a({ 12, 15 }, nextComplex);
+
+  // act
+  wilt::NArray<std::complex<double>, 2> x = wilt::ifft(wilt::fft(a, 0), 0);
+  wilt::NArray<std::complex<double>, 2> y = wilt::ifft(wilt::fft(a, 1), 1);
+
+  // assert
+  for (wilt::pos_t i = 0; i < 12; ++i)
+    for (wilt::pos_t j = 0; j < 15; ++j)
+    {
+      REQUIRE(std::abs(x.at(i, j) - a.at(i, j)) < 1e-9);
+      REQUIRE(std::abs(y.at(i, j) - a.at(i, j)) < 1e-9);
+    }
+}
+
+TEST_CASE("rfft(arr, dim) gets the non-negative frequency terms of real input")
+{
+  for (wilt::pos_t n : { 1, 7, 8, 20 })
+  {
+    // arrange
+    wilt::NArray<double, 2> a({ 3, n }, next);
+
+    // act
+    wilt::NArray<std::complex<double>, 2> b = wilt::rfft(a, 1);
+
+    // assert
+    REQUIRE(b.sizes() == wilt::Point<2>(3, n / 2 + 1));
+    for (wilt::pos_t i = 0; i < 3; ++i)
+    {
+      std::vector<std::complex<double>> expected = naiveDft(a.sliceX(i));
+      for (wilt::pos_t k = 0; k < n / 2 + 1; ++k)
+        REQUIRE(std::abs(b.at(i, k) - expected[k]) < 1e-9);
+    }
+  }
+}
+
+TEST_CASE("fft(arr, dim) throws if dimension is larger than N")
+{
+  // arrange
+  wilt::NArray<std::complex<double>, 2> a({ 2, 3 });
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::fft(a, 2), std::out_of_range);
+}
@@ -0,0 +1,318 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: imagingtests.cpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Tests for the NArray imaging structures and functions
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "../src/wilt-narray/imaging.hpp"
+
+namespace
+{
+  int counter = 0;
+  int next() { return ++counter % 11; }
+
+  template <class T, std::size_t N>
+  long long naiveSum(const wilt::NArray<T, N>& arr)
+  {
+    long long sum = 0;
+    arr.foreach([&sum](const T& v) { sum += v; });
+    return sum;
+  }
+}
+
+TEST_CASE("IntegralImage<T, N>() creates an empty integral image")
+{
+  // act
+  wilt::IntegralImage<int, 2> ii;
+
+  // assert
+  REQUIRE(ii.empty());
+  REQUIRE(ii.table().empty());
+  REQUIRE_THROWS(ii.sum({ 0, 0 }, { 1, 1 }));
+}
+
+TEST_CASE("IntegralImage<T, N>(arr) creates a padded summed-area table")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 }, { 1, 2, 3, 4, 5, 6 });
+
+  // act
+  wilt::IntegralImage<int, 2> ii(a);
+
+  // assert
+  REQUIRE(!ii.empty());
+  REQUIRE(ii.sizes() == wilt::Point<2>(2, 3));
+  REQUIRE(ii.table().sizes() == wilt::Point<2>(3, 4));
+  REQUIRE(ii.table().at(0, 0) == 0);
+  REQUIRE(ii.table().at(0, 3) == 0);
+  REQUIRE(ii.table().at(2, 0) == 0);
+  REQUIRE(ii.table().at(1, 1) == 1);
+  REQUIRE(ii.table().at(1, 3) == 6);
+  REQUIRE(ii.table().at(2, 2) == 12);
+  REQUIRE(ii.table().at(2, 3) == 21);
+}
+
+TEST_CASE("sum(loc, size) gives the same result as summing the subarray")
+{
+  // arrange
+  wilt::NArray<std::uint8_t, 3> a = wilt::NArray<int, 3>({ 5, 6, 7 }, next).convertTo<std::uint8_t>();
+  wilt::IntegralImage<long long, 3> ii(a);
+
+  // assert
+  for (wilt::pos_t x = 0; x < 5; ++x)
+    for (wilt::pos_t y = 0; y < 6; ++y)
+      for (wilt::pos_t z = 0; z < 7; ++z)
+      {
+        wilt::Point<3> loc(x, y, z);
+        wilt::Point<3> size(5 - x, (7 - y) / 2, 7 - z);
+        REQUIRE(ii.sum(loc, size) == naiveSum(a.subarray(loc, size)));
+      }
+}
+
+TEST_CASE("sum(loc, size) works on a transformed source array")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 8, 9 }, next);
+  wilt::NArray<int, 2> t = a.transpose().flipX().skipY(2);
+  wilt::IntegralImage<int, 2> ii(t);
+
+  // assert
+  REQUIRE(ii.sum({ 0, 0 }, t.sizes()) == naiveSum(t));
+  REQUIRE(ii.sum({ 2, 1 }, { 3, 2 }) == naiveSum(t.subarray({ 2, 1 }, { 3, 2 })));
+}
+
+TEST_CASE("sum(loc, size) throws if the box is out of bounds")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 4, 4 }, 1);
+  wilt::IntegralImage<int, 2> ii(a);
+
+  // assert
+  REQUIRE_THROWS(ii.sum({ -1, 0 }, { 2, 2 }));
+  REQUIRE_THROWS(ii.sum({ 3, 0 }, { 2, 2 }));
+  REQUIRE_THROWS(ii.sum({ 0, 0 }, { 0, 2 }));
+}
+
+TEST_CASE("sums(boxes) evaluates each box")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 6, 6 }, next);
+  wilt::IntegralImage<int, 2> ii(a);
+  wilt::NArray<wilt::pos_t, 2> boxes({ 3, 4 }, { 0, 0, 6, 6, 1, 2, 3, 1, 5, 5, 1, 1 });
+
+  // act
+  wilt::NArray<int, 1> sums = ii.sums(boxes);
+
+  // assert
+  REQUIRE(sums.sizes() == wilt::Point<1>(3));
+  REQUIRE(sums.at(0) == naiveSum(a));
+  REQUIRE(sums.at(1) == naiveSum(a.subarray({ 1, 2 }, { 3, 1 })));
+  REQUIRE(sums.at(2) == a.at(5, 5));
+}
+
+TEST_CASE("sums(boxes) throws if boxes don't have 2*N columns or are out of bounds")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 6, 6 }, next);
+  wilt::IntegralImage<int, 2> ii(a);
+
+  // assert
+  REQUIRE_THROWS(ii.sums(wilt::NArray<wilt::pos_t, 2>({ 1, 3 }, { 0, 0, 1 })));
+  REQUIRE_THROWS(ii.sums(wilt::NArray<wilt::pos_t, 2>({ 1, 4 }, { 0, 0, 7, 1 })));
+}
+
+TEST_CASE("resize(arr, newSize, NEAREST) repeats the nearest elements")
+{
+  // arrange
+  wilt::NArray<int, 1> a({ 3 }, { 1, 2, 3 });
+
+  // act
+  wilt::NArray<int, 1> b = wilt::resize(a, { 6 }, wilt::NEAREST);
+
+  // assert
+  int expected[] = { 1, 1, 2, 2, 3, 3 };
+  REQUIRE(b.sizes() == wilt::Point<1>(6));
+  REQUIRE(std::equal(b.begin(), b.end(), expected));
+}
+
+TEST_CASE("resize(arr, newSize, LINEAR) interpolates between element centers")
+{
+  // arrange
+  wilt::NArray<float, 1> a({ 2 }, { 0.0f, 10.0f });
+
+  // act
+  wilt::NArray<float, 1> b = wilt::resize(a, { 4 }, wilt::LINEAR);
+
+  // assert
+  REQUIRE(b.at(0) == Approx(0.0f));
+  REQUIRE(b.at(1) == Approx(2.5f));
+  REQUIRE(b.at(2) == Approx(7.5f));
+  REQUIRE(b.at(3) == Approx(10.0f));
+}
+
+TEST_CASE("resize(arr, newSize, AREA) averages the covered elements when shrinking")
+{
+  // arrange
+  wilt::NArray<float, 2> a({ 6, 9 }, next);
+
+  // act
+  wilt::NArray<float, 2> b = wilt::resize(a, { 2, 3 }, wilt::AREA);
+
+  // assert
+  REQUIRE(b.sizes() == wilt::Point<2>(2, 3));
+  for (wilt::pos_t i = 0; i < 2; ++i)
+    for (wilt::pos_t j = 0; j < 3; ++j)
+      REQUIRE(b.at(i, j) == Approx(naiveSum(a.subarray({ i * 3, j * 3 }, { 3, 3 })) / 9.0));
+}
+
+TEST_CASE("resize(arr, newSize, type) keeps channels separate")
+{
+  // arrange
+  wilt::NArray<std::uint8_t, 3> a({ 5, 7, 3 });
+  for (wilt::pos_t c = 0; c < 3; ++c)
+    a.sliceZ(c).setTo(std::uint8_t(10 * c + 5));
+
+  for (wilt::NArrayInterpolationType type : { wilt::NEAREST, wilt::LINEAR, wilt::CUBIC, wilt::AREA })
+  {
+    // act
+    wilt::NArray<std::uint8_t, 3> b = wilt::resize(a, { 9, 4, 3 }, type);
+
+    // assert
+    REQUIRE(b.sizes() == wilt::Point<3>(9, 4, 3));
+    for (wilt::pos_t c = 0; c < 3; ++c)
+      b.sliceZ(c).foreach([c](std::uint8_t v) { REQUIRE(v == 10 * c + 5); });
+  }
+}
+
+TEST_CASE("resize(arr, newSize, CUBIC) rounds and clamps integer results")
+{
+  // arrange
+  wilt::NArray<std::uint8_t, 2> a({ 4, 4 }, { 0, 0, 255, 255, 0, 0, 255, 255, 255, 255, 0, 0, 255, 255, 0, 0 });
+  wilt::NArray<float, 2> f = a.convertTo<float>();
+
+  // act
+  wilt::NArray<std::uint8_t, 2> b = wilt::resize(a, { 11, 13 }, wilt::CUBIC);
+  wilt::NArray<float, 2> c = wilt::resize(f, { 11, 13 }, wilt::CUBIC);
+
+  // assert
+  for (wilt::pos_t i = 0; i < 11; ++i)
+    for (wilt::pos_t j = 0; j < 13; ++j)
+      REQUIRE(b.at(i, j) == (int)std::floor(std::min(std::max(c.at(i, j), 0.0f), 255.0f) + 0.5f));
+}
+
+TEST_CASE("resize(arr, newSize, type) works on transformed arrays")
+{
+  // arrange
+  wilt::NArray<float, 2> a({ 7, 5 }, next);
+
+  // act
+  wilt::NArray<float, 2> b = wilt::resize(a.transpose(), { 8, 3 }, wilt::LINEAR);
+  wilt::NArray<float, 2> c = wilt::resize(a, { 3, 8 }, wilt::LINEAR);
+
+  // assert
+  for (wilt::pos_t i = 0; i < 8; ++i)
+    for (wilt::pos_t j = 0; j < 3; ++j)
+      REQUIRE(b.at(i, j) == Approx(c.at(j, i)));
+}
+
+TEST_CASE("pyrDown(arr) blurs with a Gaussian kernel and halves the first two dimensions")
+{
+  // arrange
+  wilt::NArray<float, 2> a({ 9, 12 }, next);
+  auto v = wilt::paddedView(a, wilt::REFLECT);
+  float kernel[] = { 1, 4, 6, 4, 1 };
+
+  // act
+  wilt::NArray<float, 2> b = wilt::pyrDown(a);
+
+  // assert
+  REQUIRE(b.sizes() == wilt::Point<2>(5, 6));
+  for (wilt::pos_t i = 0; i < 5; ++i)
+    for (wilt::pos_t j = 0; j < 6; ++j)
+    {
+      float sum = 0;
+      for (wilt::pos_t k = 0; k < 5; ++k)
+        for (wilt::pos_t l = 0; l < 5; ++l)
+          sum += kernel[k] * kernel[l] * v.at({ 2 * i + k - 2, 2 * j + l - 2 });
+      REQUIRE(b.at(i, j) == Approx(sum / 256));
+    }
+}
+
+TEST_CASE("pyrDown(arr) and pyrUp(arr) keep further dimensions as channels")
+{
+  // arrange
+  wilt::NArray<std::uint8_t, 3> a({ 6, 7, 3 });
+  for (wilt::pos_t c = 0; c < 3; ++c)
+    a.sliceZ(c).setTo(std::uint8_t(50 * c + 1));
+
+  // act
+  wilt::NArray<std::uint8_t, 3> b = wilt::pyrDown(a);
+  wilt::NArray<std::uint8_t, 3> c = wilt::pyrUp(a);
+
+  // assert
+  REQUIRE(b.sizes() == wilt::Point<3>(3, 4, 3));
+  REQUIRE(c.sizes() == wilt::Point<3>(12, 14, 3));
+  for (wilt::pos_t n = 0; n < 3; ++n)
+  {
+    b.sliceZ(n).foreach([n](std::uint8_t v) { REQUIRE(v == 50 * n + 1); });
+    c.sliceZ(n).foreach([n](std::uint8_t v) { REQUIRE(v == 50 * n + 1); });
+  }
+}
+
+TEST_CASE("pyrUp(arr) interpolates with a Gaussian kernel")
+{
+  // arrange
+  wilt::NArray<float, 1> a({ 4 }, { 8, 16, 0, 8 });
+
+  // act
+  wilt::NArray<float, 1> b = wilt::pyrUp(a);
+
+  // assert
+  float expected[] = { 10, 12, 13, 8, 3, 4, 6, 4 };
+  REQUIRE(b.sizes() == wilt::Point<1>(8));
+  for (wilt::pos_t i = 0; i < 8; ++i)
+    REQUIRE(b.at(i) == Approx(expected[i]));
+}
+
+TEST_CASE("GaussianPyramid(arr, levels) holds successively halved arrays")
+{
+  // arrange
+  wilt::NArray<float, 2> a({ 64, 48 }, next);
+
+  // act
+  wilt::GaussianPyramid<float, 2> p(a, 4);
+
+  // assert
+  REQUIRE(p.levels() == 4);
+  REQUIRE(p.level(0).data() == a.data());
+  REQUIRE(p.level(1).sizes() == wilt::Point<2>(32, 24));
+  REQUIRE(p.level(3).sizes() == wilt::Point<2>(8, 6));
+  REQUIRE_THROWS_AS(p.level(4), std::out_of_range);
+}
@@ -0,0 +1,499 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: indexingtests.cpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Tests for the NArray indexing functions
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "../src/wilt-narray/indexing.hpp"
+
+namespace
+{
+  int counter = 0;
+  int next() { return ++counter % 7; }
+}
+
+TEST_CASE("compact(arr, mask) copies the elements where the mask is set")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 }, { 1, 2, 3, 4, 5, 6 });
+  wilt::NArray<bool, 2> m({ 2, 3 }, { true, false, true, false, false, true });
+
+  // act
+  wilt::NArray<int, 1> b = wilt::compact(a, m);
+
+  // assert
+  REQUIRE(b.sizes() == wilt::Point<1>(3));
+  REQUIRE(b.at(0) == 1);
+  REQUIRE(b.at(1) == 3);
+  REQUIRE(b.at(2) == 6);
+}
+
+TEST_CASE("compact(arr, mask) works on large transformed arrays")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 40, 30, 50 }, next);
+  wilt::NArray<int, 3> t = a.transpose(0, 2).flipX();
+  wilt::NArray<bool, 3> m = wilt::compareGT(t, 3);
+
+  // act
+  wilt::NArray<int, 1> b = wilt::compact(t, m);
+
+  // assert
+  std::vector<int> expected;
+  for (int v : t)
+    if (v > 3)
+      expected.push_back(v);
+  REQUIRE(b.size() == expected.size());
+  REQUIRE(std::equal(b.begin(), b.end(), expected.begin()));
+}
+
+TEST_CASE("compact(arr, mask) creates an empty array if no elements are set")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 }, next);
+  wilt::NArray<bool, 2> m({ 2, 3 }, false);
+
+  // act
+  wilt::NArray<int, 1> b = wilt::compact(a, m);
+
+  // assert
+  REQUIRE(b.empty());
+}
+
+TEST_CASE("compact(arr, mask) throws if the sizes don't match")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 });
+  wilt::NArray<bool, 2> m({ 3, 2 });
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::compact(a, m), std::invalid_argument);
+}
+
+TEST_CASE("where(mask) gets the positions where the mask is set")
+{
+  // arrange
+  wilt::NArray<bool, 2> m({ 2, 3 }, { false, true, false, true, false, true });
+
+  // act
+  wilt::NArray<wilt::pos_t, 2> b = wilt::where(m.transpose());
+
+  // assert
+  REQUIRE(b.sizes() == wilt::Point<2>(3, 2));
+  REQUIRE(b.at(0, 0) == 0);
+  REQUIRE(b.at(0, 1) == 1);
+  REQUIRE(b.at(1, 0) == 1);
+  REQUIRE(b.at(1, 1) == 0);
+  REQUIRE(b.at(2, 0) == 2);
+  REQUIRE(b.at(2, 1) == 1);
+}
+
+TEST_CASE("where(mask) works on large arrays")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 40, 30, 50 }, next);
+  wilt::NArray<bool, 3> m = wilt::compareEQ(a, 2);
+
+  // act
+  wilt::NArray<wilt::pos_t, 2> b = wilt::where(m);
+
+  // assert
+  wilt::pos_t n = 0;
+  for (wilt::pos_t i = 0; i < 40; ++i)
+    for (wilt::pos_t j = 0; j < 30; ++j)
+      for (wilt::pos_t k = 0; k < 50; ++k)
+        if (a.at(i, j, k) == 2)
+        {
+          REQUIRE(b.at(n, 0) == i);
+          REQUIRE(b.at(n, 1) == j);
+          REQUIRE(b.at(n, 2) == k);
+          ++n;
+        }
+  REQUIRE(b.sizes() == wilt::Point<2>(n, 3));
+}
+
+TEST_CASE("scatter(dst, mask, values) places values where the mask is set")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 }, 0);
+  wilt::NArray<bool, 2> m({ 2, 3 }, { true, false, true, false, false, true });
+  wilt::NArray<int, 1> v({ 3 }, { 7, 8, 9 });
+
+  // act
+  wilt::scatter(a, m, v);
+
+  // assert
+  REQUIRE(a.at(0, 0) == 7);
+  REQUIRE(a.at(0, 1) == 0);
+  REQUIRE(a.at(0, 2) == 8);
+  REQUIRE(a.at(1, 0) == 0);
+  REQUIRE(a.at(1, 1) == 0);
+  REQUIRE(a.at(1, 2) == 9);
+}
+
+TEST_CASE("scatter(dst, mask, values) is the inverse of compact(arr, mask)")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 40, 30, 50 }, next);
+  wilt::NArray<int, 3> b({ 40, 30, 50 }, 0);
+  wilt::NArray<bool, 3> m = wilt::compareNE(a, 0);
+
+  // act
+  wilt::scatter(b.flipZ(), m.flipZ(), wilt::compact(a.flipZ(), m.flipZ()));
+
+  // assert
+  REQUIRE(std::equal(a.begin(), a.end(), b.begin()));
+}
+
+TEST_CASE("scatter(dst, mask, values) throws if the number of values doesn't match")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 }, 0);
+  wilt::NArray<bool, 2> m({ 2, 3 }, true);
+  wilt::NArray<int, 1> v({ 5 }, 1);
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::scatter(a, m, v), std::invalid_argument);
+}
+
+TEST_CASE("take(arr, indices, dim) copies the selected positions along the dimension")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 5, 4, 3 }, next);
+  wilt::NArray<wilt::pos_t, 1> i({ 4 }, { 3, 0, 3, 1 });
+
+  // act
+  wilt::NArray<int, 3> x = wilt::take(a, i, 0);
+  wilt::NArray<int, 3> y = wilt::take(a, i, 1);
+
+  // assert
+  REQUIRE(x.sizes() == wilt::Point<3>(4, 4, 3));
+  REQUIRE(y.sizes() == wilt::Point<3>(5, 4, 3));
+  for (wilt::pos_t n = 0; n < 4; ++n)
+    for (wilt::pos_t p = 0; p < 4; ++p)
+      for (wilt::pos_t q = 0; q < 3; ++q)
+        REQUIRE(x.at(n, p, q) == a.at(i.at(n), p, q));
+  for (wilt::pos_t p = 0; p < 5; ++p)
+    for (wilt::pos_t n = 0; n < 4; ++n)
+      for (wilt::pos_t q = 0; q < 3; ++q)
+        REQUIRE(y.at(p, n, q) == a.at(p, i.at(n), q));
+}
+
+TEST_CASE("take(arr, indices, dim) works on transformed and 1-dimensional arrays")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 6, 7 }, next);
+  wilt::NArray<int, 2> t = a.transpose().flipX();
+  wilt::NArray<int, 1> v({ 5 }, { 10, 20, 30, 40, 50 });
+  wilt::NArray<wilt::pos_t, 1> i({ 3 }, { 6, 2, 4 });
+
+  // act
+  wilt::NArray<int, 2> x = wilt::take(t, i, 0);
+  wilt::NArray<int, 1> y = wilt::take(v.flipX(), i.rangeX(1, 2), 0);
+
+  // assert
+  for (wilt::pos_t n = 0; n < 3; ++n)
+    for (wilt::pos_t p = 0; p < 6; ++p)
+      REQUIRE(x.at(n, p) == t.at(i.at(n), p));
+  REQUIRE(y.sizes() == wilt::Point<1>(2));
+  REQUIRE(y.at(0) == 30);
+  REQUIRE(y.at(1) == 10);
+}
+
+TEST_CASE("take(arr, indices, dim) throws if an index is out of bounds")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 }, next);
+  wilt::NArray<wilt::pos_t, 1> i({ 2 }, { 0, 3 });
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::take(a, i, 1), std::out_of_range);
+  REQUIRE_THROWS_AS(wilt::take(a, i, 2), std::out_of_range);
+}
+
+TEST_CASE("put(dst, indices, values, dim) copies values into the selected positions")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 5, 4, 3 }, 0);
+  wilt::NArray<int, 3> v({ 5, 2, 3 }, next);
+  wilt::NArray<wilt::pos_t, 1> i({ 2 }, { 3, 1 });
+
+  // act
+  wilt::put(a, i, v, 1);
+
+  // assert
+  for (wilt::pos_t p = 0; p < 5; ++p)
+    for (wilt::pos_t q = 0; q < 3; ++q)
+    {
+      REQUIRE(a.at(p, 0, q) == 0);
+      REQUIRE(a.at(p, 1, q) == v.at(p, 1, q));
+      REQUIRE(a.at(p, 2, q) == 0);
+      REQUIRE(a.at(p, 3, q) == v.at(p, 0, q));
+    }
+}
+
+TEST_CASE("put(dst, indices, values, dim) keeps the last value for repeated indices")
+{
+  // arrange
+  wilt::NArray<int, 1> a(wilt::Point<1>{ 4 }, 0);
+  wilt::NArray<int, 1> v(wilt::Point<1>{ 100000 });
+  wilt::NArray<wilt::pos_t, 1> i(wilt::Point<1>{ 100000 });
+  for (wilt::pos_t n = 0; n < 100000; ++n)
+  {
+    v.at(n) = (int)n;
+    i.at(n) = n % 3;
+  }
+
+  // act
+  wilt::put(a, i, v, 0);
+
+  // assert
+  REQUIRE(a.at(0) == 99999);
+  REQUIRE(a.at(1) == 99997);
+  REQUIRE(a.at(2) == 99998);
+  REQUIRE(a.at(3) == 0);
+}
+
+TEST_CASE("put(dst, indices, values, dim) undoes take(arr, indices, dim) for a permutation")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 300, 200 }, next);
+  wilt::NArray<wilt::pos_t, 1> i({ 300 }, [](){ static wilt::pos_t n = 0; return (n++ * 7) % 300; });
+  wilt::NArray<int, 2> b({ 300, 200 }, 0);
+
+  // act
+  wilt::put(b, i, wilt::take(a, i, 0), 0);
+
+  // assert
+  REQUIRE(std::equal(a.begin(), a.end(), b.begin()));
+}
+
+TEST_CASE("put(dst, indices, values, dim) throws if the sizes don't match")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 4, 3 }, 0);
+  wilt::NArray<int, 2> v({ 2, 2 }, 1);
+  wilt::NArray<wilt::pos_t, 1> i({ 2 }, { 0, 1 });
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::put(a, i, v, 0), std::invalid_argument);
+}
+
+TEST_CASE("concat(dim, arrs) joins arrays along the dimension")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 }, next);
+  wilt::NArray<int, 2> b({ 2, 1 }, next);
+  wilt::NArray<int, 2> c({ 4, 2 }, next);
+
+  // act
+  wilt::NArray<int, 2> x = wilt::concat(1, { a, b, c.rangeX(1, 2).flipY() });
+  wilt::NArray<int, 2> y = wilt::concat(0, { a, wilt::NArray<int, 2>(), c.transpose().rangeY(0, 3) });
+
+  // assert
+  REQUIRE(x.sizes() == wilt::Point<2>(2, 6));
+  REQUIRE(y.sizes() == wilt::Point<2>(4, 3));
+  for (wilt::pos_t i = 0; i < 2; ++i)
+  {
+    for (wilt::pos_t j = 0; j < 3; ++j) REQUIRE(x.at(i, j) == a.at(i, j));
+    REQUIRE(x.at(i, 3) == b.at(i, 0));
+    for (wilt::pos_t j = 0; j < 2; ++j) REQUIRE(x.at(i, 4 + j) == c.at(1 + i, 1 - j));
+  }
+  for (wilt::pos_t j = 0; j < 3; ++j)
+  {
+    for (wilt::pos_t i = 0; i < 2; ++i) REQUIRE(y.at(i, j) == a.at(i, j));
+    for (wilt::pos_t i = 0; i < 2; ++i) REQUIRE(y.at(2 + i, j) == c.at(j, i));
+  }
+}
+
+TEST_CASE("concat(dim, arrs) joins many tiles from a vector")
+{
+  // arrange
+  std::vector<wilt::NArray<int, 2>> tiles;
+  for (int n = 0; n < 12; ++n)
+    tiles.emplace_back(wilt::Point<2>(64, 48), n);
+
+  // act
+  wilt::NArray<int, 2> a = wilt::concat(0, tiles);
+
+  // assert
+  REQUIRE(a.sizes() == wilt::Point<2>(768, 48));
+  for (wilt::pos_t i = 0; i < 768; ++i)
+    REQUIRE(a.at(i, 47) == i / 64);
+}
+
+TEST_CASE("concat(dim, arrs) throws if the sizes don't match")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 });
+  wilt::NArray<int, 2> b({ 3, 3 });
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::concat(1, { a, b }), std::invalid_argument);
+  REQUIRE_THROWS_AS(wilt::concat(2, { a, b }), std::out_of_range);
+}
+
+TEST_CASE("stack(dim, arrs) joins arrays along a new dimension")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 }, next);
+  wilt::NArray<int, 2> b({ 3, 2 }, next);
+
+  // act
+  wilt::NArray<int, 3> x = wilt::stack(0, { a, b.transpose() });
+  wilt::NArray<int, 3> y = wilt::stack(2, { a, b.transpose(), a });
+
+  // assert
+  REQUIRE(x.sizes() == wilt::Point<3>(2, 2, 3));
+  REQUIRE(y.sizes() == wilt::Point<3>(2, 3, 3));
+  for (wilt::pos_t i = 0; i < 2; ++i)
+    for (wilt::pos_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(x.at(0, i, j) == a.at(i, j));
+      REQUIRE(x.at(1, i, j) == b.at(j, i));
+      REQUIRE(y.at(i, j, 0) == a.at(i, j));
+      REQUIRE(y.at(i, j, 1) == b.at(j, i));
+      REQUIRE(y.at(i, j, 2) == a.at(i, j));
+    }
+}
+
+TEST_CASE("stack(dim, arrs) throws if the sizes don't match")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 });
+  wilt::NArray<int, 2> b({ 3, 2 });
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::stack(0, { a, b }), std::invalid_argument);
+  REQUIRE_THROWS_AS(wilt::stack(3, { a, a }), std::out_of_range);
+}
+
+TEST_CASE("split(arr, dim, sizes) returns views of consecutive ranges")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 3, 6 }, next);
+
+  // act
+  std::vector<wilt::NArray<int, 2>> parts = wilt::split(a, 1, { 1, 3, 2 });
+
+  // assert
+  REQUIRE(parts.size() == 3);
+  REQUIRE(parts[0].sizes() == wilt::Point<2>(3, 1));
+  REQUIRE(parts[1].sizes() == wilt::Point<2>(3, 3));
+  REQUIRE(parts[2].sizes() == wilt::Point<2>(3, 2));
+  REQUIRE(parts[1].data() == &a.at(0, 1));
+  REQUIRE(parts[2].data() == &a.at(0, 4));
+  REQUIRE(wilt::concat(1, parts).sizes() == a.sizes());
+}
+
+TEST_CASE("split(arr, dim, sizes) throws if the sizes don't add up")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 3, 6 });
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::split(a, 1, { 1, 3 }), std::invalid_argument);
+  REQUIRE_THROWS_AS(wilt::split(a, 1, { 7, -1 }), std::invalid_argument);
+}
+
+TEST_CASE("pad(arr, before, after, type, value) pads with each border type")
+{
+  // arrange
+  wilt::NArray<int, 1> a({ 4 }, { 1, 2, 3, 4 });
+
+  // act
+  wilt::NArray<int, 1> c = wilt::pad(a, { 2 }, { 3 }, wilt::CONSTANT, 9);
+  wilt::NArray<int, 1> e = wilt::pad(a, { 2 }, { 3 }, wilt::EDGE);
+  wilt::NArray<int, 1> r = wilt::pad(a, { 2 }, { 3 }, wilt::REFLECT);
+  wilt::NArray<int, 1> w = wilt::pad(a, { 2 }, { 3 }, wilt::WRAP);
+
+  // assert
+  int ec[] = { 9, 9, 1, 2, 3, 4, 9, 9, 9 };
+  int ee[] = { 1, 1, 1, 2, 3, 4, 4, 4, 4 };
+  int er[] = { 3, 2, 1, 2, 3, 4, 3, 2, 1 };
+  int ew[] = { 3, 4, 1, 2, 3, 4, 1, 2, 3 };
+  REQUIRE(c.sizes() == wilt::Point<1>(9));
+  REQUIRE(std::equal(c.begin(), c.end(), ec));
+  REQUIRE(std::equal(e.begin(), e.end(), ee));
+  REQUIRE(std::equal(r.begin(), r.end(), er));
+  REQUIRE(std::equal(w.begin(), w.end(), ew));
+}
+
+TEST_CASE("pad(arr, before, after, type, value) matches a padded view in every dimension")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 4, 3, 5 }, next);
+  wilt::NArray<int, 3> t = a.transpose(0, 2).flipY();
+  wilt::Point<3> before(2, 0, 7);
+  wilt::Point<3> after(1, 4, 3);
+
+  for (wilt::NArrayBorderType type : { wilt::CONSTANT, wilt::EDGE, wilt::REFLECT, wilt::WRAP })
+  {
+    // act
+    wilt::NArray<int, 3> b = wilt::pad(t, before, after, type, -1);
+    wilt::PaddedView<int, 3> v = wilt::paddedView(t, type, -1);
+
+    // assert
+    REQUIRE(b.sizes() == wilt::Point<3>(8, 7, 14));
+    for (wilt::pos_t i = 0; i < 8; ++i)
+      for (wilt::pos_t j = 0; j < 7; ++j)
+        for (wilt::pos_t k = 0; k < 14; ++k)
+          REQUIRE(b.at(i, j, k) == v.at({ i - 2, j, k - 7 }));
+  }
+}
+
+TEST_CASE("paddedView(arr, type, value) resolves locations outside the array")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 }, { 1, 2, 3, 4, 5, 6 });
+
+  // act
+  auto c = wilt::paddedView(a, wilt::CONSTANT, 0);
+  auto e = wilt::paddedView(a, wilt::EDGE);
+  auto r = wilt::paddedView(a, wilt::REFLECT);
+  auto w = wilt::paddedView(a, wilt::WRAP);
+
+  // assert
+  REQUIRE(c.at({ 1, 2 }) == 6);
+  REQUIRE(c.at({ -1, 0 }) == 0);
+  REQUIRE(e.at({ -5, 9 }) == 3);
+  REQUIRE(r.at({ 2, -1 }) == 2);
+  REQUIRE(r.at({ 0, 5 }) == 2);
+  REQUIRE(w.at({ -1, 3 }) == 4);
+  REQUIRE(w.at({ 4, -4 }) == 3);
+}
+
+TEST_CASE("pad(arr, before, after, type, value) throws on negative padding")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 });
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::pad(a, { 0, -1 }, { 0, 0 }, wilt::EDGE), std::invalid_argument);
+}
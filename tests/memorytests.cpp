@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: memorytests.cpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Tests for the optional memory accounting
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// tracked and untracked arrays can't be mixed in one program, so this file
+// is its own test executable
+#define WILT_NARRAY_TRACK_MEMORY
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include "../src/wilt-narray/narray.hpp"
+
+namespace
+{
+  bool findBlock(const void* data, wilt::NArrayBlockInfo& found)
+  {
+    for (const wilt::NArrayBlockInfo& info : wilt::memoryBlocks())
+    {
+      if (info.data == data)
+      {
+        found = info;
+        return true;
+      }
+    }
+    return false;
+  }
+}
+
+TEST_CASE("memoryBlocks() reports a live block and the arrays viewing it")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 10, 20 }, 1);
+  wilt::NArray<int, 2> b = a;
+  wilt::NArrayBlockInfo info;
+
+  // act
+  bool found = findBlock(a.data(), info);
+
+  // assert
+  REQUIRE(found);
+  REQUIRE(info.bytes == 200 * sizeof(int));
+  REQUIRE(info.reachableBytes == 200 * sizeof(int));
+  REQUIRE(info.views == 2);
+}
+
+TEST_CASE("memoryBlocks() only counts the bytes that views can reach")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 10, 20 }, 1);
+  const void* data = a.data();
+  wilt::NArray<int, 2> b = a.rangeX(2, 1).flipY();
+  wilt::NArray<int, 2> c = a.rangeX(6, 2);
+  wilt::NArrayBlockInfo info;
+
+  // act
+  a.clear();
+  bool found = findBlock(data, info);
+
+  // assert
+  REQUIRE(found);
+  REQUIRE(info.bytes == 200 * sizeof(int));
+  REQUIRE(info.reachableBytes == 60 * sizeof(int));
+  REQUIRE(info.views == 2);
+}
+
+TEST_CASE("memoryBlocks() no longer reports a block once its arrays are gone")
+{
+  // arrange
+  const void* data = nullptr;
+  wilt::NArrayBlockInfo info;
+
+  // act
+  {
+    wilt::NArray<int, 1> a(wilt::Point<1>{ 50 });
+    data = a.data();
+    REQUIRE(findBlock(data, info));
+  }
+
+  // assert
+  REQUIRE(!findBlock(data, info));
+}
+
+TEST_CASE("pinnedBlocks(fraction) reports blocks kept alive by small views")
+{
+  // arrange
+  wilt::NArray<int, 1> a(wilt::Point<1>{ 1000 }, 1);
+  wilt::NArray<int, 1> b(wilt::Point<1>{ 1000 }, 1);
+  const void* data = a.data();
+  a = a.rangeX(10, 5);
+
+  // act
+  std::vector<wilt::NArrayBlockInfo> pinned = wilt::pinnedBlocks(0.1);
+  std::ostringstream report;
+  wilt::writeMemoryReport(report, 0.1);
+
+  // assert
+  auto it = std::find_if(pinned.begin(), pinned.end(), [data](const wilt::NArrayBlockInfo& info) { return info.data == data; });
+  REQUIRE(it != pinned.end());
+  REQUIRE(it->reachableBytes == 5 * sizeof(int));
+  REQUIRE(std::none_of(pinned.begin(), pinned.end(), [&b](const wilt::NArrayBlockInfo& info) { return info.data == b.data(); }));
+  REQUIRE(report.str().find("pinned block") != std::string::npos);
+}
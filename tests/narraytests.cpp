@@ -29,8 +29,8 @@
 
 #include <cassert>
 #include <algorithm>
-#include <chrono>
-#include <iostream>
+#include <cstdint>
+#include <limits>
 
 #include "../src/wilt-narray/narray.hpp"
 
@@ -405,6 +405,77 @@ TEST_CASE("NArray<T, N>(size, val) creates empty array when given size with a ne
   REQUIRE_THROWS(wilt::NArray<int, 2>({ 3, -2 }, 1));
 }
 
+TEST_CASE("NArray<T, N>(size, val) fills large arrays under either numa policy")
+{
+  for (auto policy : { wilt::NUMA_LOCAL, wilt::NUMA_INTERLEAVE })
+  {
+    // arrange
+    wilt::setNumaPolicy(policy);
+
+    // act
+    wilt::NArray<int, 2> a({ 300, 1000 }, 7);
+
+    // assert
+    REQUIRE(std::all_of(a.begin(), a.end(), [](int v) { return v == 7; }));
+  }
+  wilt::setNumaPolicy(wilt::NUMA_LOCAL);
+}
+
+TEST_CASE("NArray<T, N>(size, gen) calls the generator in order under either numa policy")
+{
+  for (auto policy : { wilt::NUMA_LOCAL, wilt::NUMA_INTERLEAVE })
+  {
+    // arrange
+    wilt::setNumaPolicy(policy);
+    int i = 0;
+
+    // act
+    wilt::NArray<int, 1> a(wilt::Point<1>{ 300000 }, [&i]() { return i++; });
+
+    // assert
+    REQUIRE(a.at(0) == 0);
+    REQUIRE(a.at(123456) == 123456);
+    REQUIRE(a.at(299999) == 299999);
+  }
+  wilt::setNumaPolicy(wilt::NUMA_LOCAL);
+}
+
+TEST_CASE("NArray<T, N>(size, val, storage) creates arrays backed by huge pages")
+{
+  for (auto storage : { wilt::HUGE_PAGES, wilt::HUGE_PAGES_PREFAULT })
+  {
+    // act
+    wilt::NArray<int, 2> a({ 300, 1000 }, 3, storage);
+    wilt::NArray<double, 1> b(wilt::Point<1>{ 5 }, storage);
+
+    // assert
+    REQUIRE(std::all_of(a.begin(), a.end(), [](int v) { return v == 3; }));
+    REQUIRE(b.size() == 5);
+#if defined(__linux__)
+    REQUIRE(reinterpret_cast<std::uintptr_t>(a.data()) % (1 << 21) == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b.data()) % (1 << 21) == 0);
+#endif
+  }
+}
+
+TEST_CASE("setHugePageThreshold(bytes) makes large arrays use huge pages by default")
+{
+  // arrange
+  wilt::setHugePageThreshold(1 << 20);
+
+  // act
+  wilt::NArray<char, 1> a(wilt::Point<1>{ 1 << 20 });
+  wilt::NArray<char, 1> b(wilt::Point<1>{ 1 << 20 }, wilt::REGULAR_PAGES);
+  wilt::setHugePageThreshold(std::numeric_limits<std::size_t>::max());
+
+  // assert
+  REQUIRE(a.size() == (1 << 20));
+  REQUIRE(b.size() == (1 << 20));
+#if defined(__linux__)
+  REQUIRE(reinterpret_cast<std::uintptr_t>(a.data()) % (1 << 21) == 0);
+#endif
+}
+
 TEST_CASE("NArray<T, N>(size, first, last) creates array with the correct size")
 {
   // arrange
@@ -970,6 +1041,34 @@ TEST_CASE("repeat(n) throws when called on an empty array")
   REQUIRE_THROWS(empty.repeat(5));
 }
 
+TEST_CASE("isRepeated() is true for array with repeated dimensions")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 });
+
+  // assert
+  REQUIRE(!a.isRepeated());
+  REQUIRE(a.repeat(4).isRepeated());
+  REQUIRE(a.repeat(4).transpose(0, 2).isRepeated());
+  REQUIRE(!a.repeat(1).isRepeated());
+  REQUIRE(!a.repeat(4).isContiguous());
+}
+
+TEST_CASE("foreach(op) visits every element of a repeated array")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 2, 3 }, 1);
+  int count = 0;
+  int sum = 0;
+
+  // act
+  a.repeat(4).transpose(0, 2).foreach([&](int v) { ++count; sum += v; });
+
+  // assert
+  REQUIRE(count == 24);
+  REQUIRE(sum == 24);
+}
+
 TEST_CASE("window(dim, n) creates an array with the correct size")
 {
   // arrange
@@ -1090,6 +1189,22 @@ TEST_CASE("window(dim, n) throws when called on an empty array")
   REQUIRE_THROWS(empty.window(1, 0));
 }
 
+TEST_CASE("Unchecked transformations are identical to the checked versions")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 4, 5, 6 });
+
+  // assert
+  REQUIRE(a.sliceUnchecked(1, 2) == a.slice(1, 2));
+  REQUIRE(a.rangeUnchecked(2, 1, 3) == a.range(2, 1, 3));
+  REQUIRE(a.flipUnchecked(1) == a.flip(1));
+  REQUIRE(a.skipUnchecked(2, 2, 1) == a.skip(2, 2, 1));
+  REQUIRE(a.transposeUnchecked(0, 2) == a.transpose(0, 2));
+  REQUIRE(a.subarrayUnchecked({ 1, 2, 3 }, { 2, 2, 2 }) == a.subarray({ 1, 2, 3 }, { 2, 2, 2 }));
+  REQUIRE(a.windowUnchecked(1, 3) == a.window(1, 3));
+  REQUIRE(a.repeatUnchecked(3) == a.repeat(3));
+}
+
 TEST_CASE("asCondensed() creates fully-condensed array from uniform array")
 {
   // act
@@ -1278,6 +1393,74 @@ TEST_CASE("clone() creates a non-const array from a const array")
   REQUIRE(b.steps() == wilt::Point<2>(2, 1));
 }
 
+TEST_CASE("compacted(threshold) copies a view that reaches little of its data")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 100, 100 }, 1);
+  wilt::NArray<int, 2> b = a.subarray({ 10, 10 }, { 4, 5 });
+
+  // act
+  wilt::NArray<int, 2> c = b.compacted(0.25);
+
+  // assert
+  REQUIRE(c.data() != b.data());
+  REQUIRE(c.sizes() == wilt::Point<2>(4, 5));
+  REQUIRE(c.steps() == wilt::Point<2>(5, 1));
+  REQUIRE(std::equal(b.begin(), b.end(), c.begin()));
+}
+
+TEST_CASE("compacted(threshold) returns the same array when it reaches enough of its data")
+{
+  // arrange
+  wilt::NArray<const int, 2> a({ 100, 100 }, 1);
+  wilt::NArray<const int, 2> b = a.rangeX(0, 60).transpose();
+
+  // act
+  wilt::NArray<const int, 2> c = a.compacted(0.25);
+  wilt::NArray<const int, 2> d = b.compacted(0.5);
+
+  // assert
+  REQUIRE(c.data() == a.data());
+  REQUIRE(d.data() == b.data());
+  REQUIRE(d.steps() == b.steps());
+}
+
+TEST_CASE("compacted(threshold) never copies data that it doesn't own")
+{
+  // arrange
+  int data[100] = { };
+  wilt::NArray<int, 1> a = wilt::make_narray(data).rangeX(0, 2);
+
+  // act
+  wilt::NArray<int, 1> b = a.compacted(1.0);
+
+  // assert
+  REQUIRE(b.data() == a.data());
+}
+
+TEST_CASE("compacted(threshold) throws when threshold isn't between 0 and 1")
+{
+  // arrange
+  wilt::NArray<int, 1> a(wilt::Point<1>{ 10 }, 1);
+
+  // assert
+  REQUIRE_THROWS_AS(a.compacted(-0.5), std::invalid_argument);
+  REQUIRE_THROWS_AS(a.compacted(1.5), std::invalid_argument);
+}
+
+TEST_CASE("convertTo() creates a converted multi-dimensional array")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 2, 3, 4 }, 3);
+
+  // act
+  wilt::NArray<float, 3> b = a.flipY().convertTo<float>();
+
+  // assert
+  REQUIRE(b.sizes() == wilt::Point<3>(2, 3, 4));
+  REQUIRE(std::all_of(b.begin(), b.end(), [](float v) { return v == 3.0f; }));
+}
+
 TEST_CASE("compress(compressor) creates smaller array using a function")
 {
   // arrange
@@ -1422,6 +1605,37 @@ TEST_CASE("operator+(value, arr) creates empty array when called with an empty a
   REQUIRE(e.empty());
 }
 
+TEST_CASE("operator+(arr, arr) can add a repeated array to an array")
+{
+  // arrange
+  wilt::NArray<int, 4> a({ 2, 3, 4, 5 }, 1);
+  wilt::NArray<int, 1> bias({ 3 }, { 10, 20, 30 });
+
+  // act
+  auto b = a + bias.repeat(2).transpose().repeat(4).repeat(5);
+
+  // assert
+  REQUIRE(b.sizes() == wilt::Point<4>(2, 3, 4, 5));
+  REQUIRE(b.at(0, 0, 0, 0) == 11);
+  REQUIRE(b.at(1, 1, 3, 4) == 21);
+  REQUIRE(b.at(1, 2, 2, 2) == 31);
+}
+
+TEST_CASE("operator+=(arr) reads a repeated element again if it was modified")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 1, 3 }, { 1, 2, 3 });
+  wilt::NArray<int, 2> b = a.sliceY(0).repeat(3);
+
+  // act
+  a += b;
+
+  // assert
+  REQUIRE(a.at(0, 0) == 2);
+  REQUIRE(a.at(0, 1) == 4);
+  REQUIRE(a.at(0, 2) == 5);
+}
+
 TEST_CASE("window()+skip() can give the same result as a reshape()+transpose()")
 {
   // arrange
@@ -1604,256 +1818,39 @@ TEST_CASE("make_narray(source) creates proper array from std::vector")
   REQUIRE(&a[1] == &data[1]);
 }
 
-int usingIterator(const wilt::NArray<int, 3>& arr)
-{
-  int sum = 0;
-  for (int v : arr)
-    sum += v;
-  return sum;
-}
-
-int usingIterator(const wilt::NArray<int, 1>& arr)
+namespace
 {
-  int sum = 0;
-  for (int v : arr)
-    sum += v;
-  return sum;
-}
-
-int usingBrackets(const wilt::NArray<int, 3>& arr)
-{
-  int sum = 0;
-  for (std::size_t x = 0; x < arr.width(); ++x)
-    for (std::size_t y = 0; y < arr.height(); ++y)
-      for (std::size_t z = 0; z < arr.height(); ++z)
-        sum += arr[x][y][z];
-  return sum;
-}
-
-int usingBrackets(const wilt::NArray<int, 1>& arr)
-{
-  int sum = 0;
-  for (std::size_t x = 0; x < arr.width(); ++x)
-    sum += arr[x];
-  return sum;
-}
-
-int usingForeach(const wilt::NArray<int, 3>& arr)
-{
-  int sum = 0;
-  arr.foreach([&](int) mutable { sum++; });
-  return sum;
-}
-
-int usingForeach(const wilt::NArray<int, 1>& arr)
-{
-  int sum = 0;
-  arr.foreach([&](int) mutable { sum++; });
-  return sum;
-}
-
-int usingAt(const wilt::NArray<int, 3>& arr)
-{
-  int sum = 0;
-  for (std::size_t x = 0; x < arr.width(); ++x)
-    for (std::size_t y = 0; y < arr.height(); ++y)
-      for (std::size_t z = 0; z < arr.height(); ++z)
-        sum += arr.atUnchecked(wilt::Point<3>((wilt::pos_t)x, (wilt::pos_t)y, (wilt::pos_t)z));
-  return sum;
-}
-
-int usingAt(const wilt::NArray<int, 1>& arr)
-{
-  int sum = 0;
-  for (std::size_t x = 0; x < arr.width(); ++x)
-    sum += arr.atUnchecked(wilt::Point<1>((wilt::pos_t)x));
-  return sum;
-}
-
-int usingRaw(const wilt::NArray<int, 3>& arr)
-{
-  int sum = 0;
-  int* data = arr.data();
-  for (std::size_t x = 0; x < arr.width(); ++x)
-  {
-    int* datax = data + x * arr.step(0);
-    for (std::size_t y = 0; y < arr.height(); ++y)
-    {
-      int* datay = datax + y * arr.step(1);
-      for (std::size_t z = 0; z < arr.height(); ++z)
-      {
-        int* dataz = datay + z * arr.step(2);
-        sum += *dataz;
-      }
-    }
-  }
-  return sum;
-}
-
-int usingRaw(const wilt::NArray<int, 1>& arr)
-{
-  int sum = 0;
-  int* base = arr.data();
-  for (std::size_t x = 0; x < arr.width(); ++x)
-  {
-    int* basex = base + x * arr.step(0);
-    sum += *basex;
-  }
-  return sum;
-}
-
-TEST_CASE("iteration performance comparisons (N=3)")
-{
-  // arrange
-  wilt::NArray<int, 3> arr = wilt::NArray<int, 3>({ 100, 100, 100 }, 1).subarray({ 1, 1, 1 }, { 98, 98, 98 });
-  const int count = arr.size();
-  const int iterations = 10;
-
-  SECTION("using iterator")
-  {
-    // act
-    auto start = std::chrono::high_resolution_clock::now();
-    auto sum = 0;
-    for (int i = 0; i < iterations; ++i)
-      sum += usingIterator(arr);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "iterator: " << (end - start).count() / 1000000.0 / iterations << "ms" << std::endl;
-
-    // assert
-    REQUIRE(sum == count * iterations);
-  }
+  // layouts worked out at compile time, as a static-extent array would
+  constexpr wilt::Point<3> layoutSizes(2, 3, 4);
+  constexpr wilt::Point<3> layoutSteps = wilt::detail::step(layoutSizes);
 
-  SECTION("using brackets")
+  constexpr wilt::Point<3> alignedSizes()
   {
-    // act
-    auto start = std::chrono::high_resolution_clock::now();
-    auto sum = 0;
-    for (int i = 0; i < iterations; ++i)
-      sum += usingBrackets(arr);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "brackets: " << (end - start).count() / 1000000.0 / iterations << "ms" << std::endl;
-
-    // assert
-    REQUIRE(sum == count * iterations);
+    wilt::Point<3> sizes = layoutSizes.swapped(0, 2);
+    wilt::Point<3> steps = layoutSteps.swapped(0, 2);
+    steps[1] = -steps[1];
+    wilt::detail::align(sizes, steps);
+    return sizes;
   }
 
-  SECTION("using foreach")
+  constexpr std::size_t condensedDims(wilt::Point<3> sizes, wilt::Point<3> steps)
   {
-    // act
-    auto start = std::chrono::high_resolution_clock::now();
-    auto sum = 0;
-    for (int i = 0; i < iterations; ++i)
-      sum += usingForeach(arr);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "for each: " << (end - start).count() / 1000000.0 / iterations << "ms" << std::endl;
-
-    // assert
-    REQUIRE(sum == count * iterations);
-  }
-
-  SECTION("using at")
-  {
-    // act
-    auto start = std::chrono::high_resolution_clock::now();
-    auto sum = 0;
-    for (int i = 0; i < iterations; ++i)
-      sum += usingAt(arr);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "fun at(): " << (end - start).count() / 1000000.0 / iterations << "ms" << std::endl;
-
-    // assert
-    REQUIRE(sum == count * iterations);
-  }
-
-  SECTION("using raw")
-  {
-    // act
-    auto start = std::chrono::high_resolution_clock::now();
-    auto sum = 0;
-    for (int i = 0; i < iterations; ++i)
-      sum += usingRaw(arr);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "raw math: " << (end - start).count() / 1000000.0 / iterations << "ms" << std::endl;
-
-    // assert
-    REQUIRE(sum == count * iterations);
+    return wilt::detail::condense(sizes, steps);
   }
 }
 
-TEST_CASE("iteration performance comparisons (N=1)")
+TEST_CASE("shape arithmetic can be evaluated at compile time")
 {
-  // arrange
-  wilt::NArray<int, 1> arr = wilt::NArray<int, 1>({ 1000000 }, 1);
-  const int iterations = 2;
-
-  SECTION("using iterator")
-  {
-    // act
-    auto start = std::chrono::high_resolution_clock::now();
-    auto sum = 0;
-    for (int i = 0; i < iterations; ++i)
-      sum += usingIterator(arr);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "iterator: " << (end - start).count() / 1000000.0 / iterations << "ms" << std::endl;
+  static_assert(layoutSteps == wilt::Point<3>(12, 4, 1), "step() must be constexpr");
+  static_assert(wilt::detail::size(layoutSizes) == 24, "size() must be constexpr");
+  static_assert(wilt::detail::validSize(layoutSizes), "validSize() must be constexpr");
+  static_assert(!wilt::detail::validSize(wilt::Point<2>(3, 0)), "validSize() must be constexpr");
+  static_assert(alignedSizes() == layoutSizes, "align() must be constexpr");
+  static_assert(condensedDims(layoutSizes, layoutSteps) == 1, "condense() must be constexpr");
+  static_assert(condensedDims(layoutSizes, layoutSteps.swapped(0, 1)) == 3, "condense() must be constexpr");
 
-    // assert
-    REQUIRE(sum == 1000000 * iterations);
-  }
-
-  SECTION("using brackets")
-  {
-    // act
-    auto start = std::chrono::high_resolution_clock::now();
-    auto sum = 0;
-    for (int i = 0; i < iterations; ++i)
-      sum += usingBrackets(arr);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "brackets: " << (end - start).count() / 1000000.0 / iterations << "ms" << std::endl;
-
-    // assert
-    REQUIRE(sum == 1000000 * iterations);
-  }
-
-  SECTION("using foreach")
-  {
-    // act
-    auto start = std::chrono::high_resolution_clock::now();
-    auto sum = 0;
-    for (int i = 0; i < iterations; ++i)
-      sum += usingForeach(arr);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "for each: " << (end - start).count() / 1000000.0 / iterations << "ms" << std::endl;
-
-    // assert
-    REQUIRE(sum == 1000000 * iterations);
-  }
-
-  SECTION("using at")
-  {
-    // act
-    auto start = std::chrono::high_resolution_clock::now();
-    auto sum = 0;
-    for (int i = 0; i < iterations; ++i)
-      sum += usingAt(arr);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "fun at(): " << (end - start).count() / 1000000.0 / iterations << "ms" << std::endl;
-
-    // assert
-    REQUIRE(sum == 1000000 * iterations);
-  }
-
-  SECTION("using raw")
-  {
-    // act
-    auto start = std::chrono::high_resolution_clock::now();
-    auto sum = 0;
-    for (int i = 0; i < iterations; ++i)
-      sum += usingRaw(arr);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "raw math: " << (end - start).count() / 1000000.0 / iterations << "ms" << std::endl;
-
-    // assert
-    REQUIRE(sum == 1000000 * iterations);
-  }
+  // the same results at runtime
+  wilt::NArray<int, 3> a(layoutSizes);
+  REQUIRE(a.steps() == layoutSteps);
+  REQUIRE(a.transpose(0, 2).flipY().asAligned().sizes() == alignedSizes());
 }
-
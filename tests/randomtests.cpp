@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: randomtests.cpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Tests for the NArray random fill functions
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "../src/wilt-narray/random.hpp"
+
+TEST_CASE("randomUniform(arr, lo, hi, seed) fills floating point values within [lo, hi)")
+{
+  // arrange
+  wilt::NArray<double, 2> a({ 300, 400 });
+
+  // act
+  wilt::randomUniform(a, -2.0, 6.0, 42);
+
+  // assert
+  double sum = 0;
+  for (double v : a)
+  {
+    REQUIRE(v >= -2.0);
+    REQUIRE(v < 6.0);
+    sum += v;
+  }
+  REQUIRE(sum / 120000 == Approx(2.0).margin(0.05));
+}
+
+TEST_CASE("randomUniform(arr, lo, hi, seed) never produces hi for float")
+{
+  // arrange
+  wilt::NArray<float, 2> a({ 4096, 4096 });
+
+  // act & assert
+  for (std::uint64_t seed = 0; seed < 4; ++seed)
+  {
+    wilt::randomUniform(a, 0.0f, 1.0f, seed);
+    REQUIRE(*std::max_element(a.begin(), a.end()) < 1.0f);
+  }
+}
+
+TEST_CASE("randomUniform(arr, lo, hi, seed) fills integer values within [lo, hi]")
+{
+  // arrange
+  wilt::NArray<int, 1> a(wilt::Point<1>{ 10000 });
+
+  // act
+  wilt::randomUniform(a, -3, 3, 7);
+
+  // assert
+  int counts[7] = { };
+  for (int v : a)
+  {
+    REQUIRE(v >= -3);
+    REQUIRE(v <= 3);
+    ++counts[v + 3];
+  }
+  for (int count : counts)
+    REQUIRE(count > 1200);
+}
+
+namespace
+{
+  // fills an array of T and checks that the values cover exactly [lo, hi]
+  template <class T>
+  bool coversRange(T lo, T hi)
+  {
+    wilt::NArray<T, 1> a(wilt::Point<1>{ 20000 });
+    wilt::randomUniform(a, lo, hi, 11);
+
+    auto minmax = std::minmax_element(a.begin(), a.end());
+    return *minmax.first == lo && *minmax.second == hi;
+  }
+}
+
+TEST_CASE("randomUniform(arr, lo, hi, seed) fills small integer types within [lo, hi]")
+{
+  REQUIRE(coversRange<std::int8_t>(-10, 10));
+  REQUIRE(coversRange<std::int8_t>(-128, 127));
+  REQUIRE(coversRange<std::uint8_t>(5, 200));
+  REQUIRE(coversRange<std::uint8_t>(0, 255));
+  REQUIRE(coversRange<std::int16_t>(-5, 5));
+  REQUIRE(coversRange<std::int16_t>(-300, -100));
+  REQUIRE(coversRange<std::uint16_t>(10, 40));
+  REQUIRE(coversRange<std::uint16_t>(65000, 65535));
+}
+
+TEST_CASE("randomUniform(arr, lo, hi, seed) depends only on the seed and element order")
+{
+  // arrange
+  wilt::NArray<float, 2> a({ 150, 250 });
+  wilt::NArray<float, 2> b({ 250, 150 });
+  wilt::NArray<float, 2> c({ 150, 250 });
+  wilt::NArray<float, 2> d({ 150, 250 });
+
+  // act
+  wilt::randomUniform(a, 0.0f, 1.0f, 1234);
+  wilt::randomUniform(b.transpose(), 0.0f, 1.0f, 1234);
+  wilt::randomUniform(c, 0.0f, 1.0f, 1234);
+  wilt::randomUniform(d, 0.0f, 1.0f, 1235);
+
+  // assert
+  wilt::NArray<float, 2> t = b.transpose();
+  REQUIRE(std::equal(a.begin(), a.end(), t.begin()));
+  REQUIRE(std::equal(a.begin(), a.end(), c.begin()));
+  REQUIRE(!std::equal(a.begin(), a.end(), d.begin()));
+}
+
+TEST_CASE("randomNormal(arr, mean, stddev, seed) fills normally distributed values")
+{
+  // arrange
+  wilt::NArray<double, 3> a({ 40, 50, 60 });
+
+  // act
+  wilt::randomNormal(a, 5.0, 2.0, 99);
+
+  // assert
+  double sum = 0, sumsq = 0, within = 0;
+  for (double v : a)
+  {
+    sum += v;
+    sumsq += v * v;
+    within += std::abs(v - 5.0) < 2.0 ? 1 : 0;
+  }
+  const double mean = sum / 120000;
+  REQUIRE(mean == Approx(5.0).margin(0.03));
+  REQUIRE(std::sqrt(sumsq / 120000 - mean * mean) == Approx(2.0).margin(0.03));
+  REQUIRE(within / 120000 == Approx(0.6827).margin(0.01));
+}
+
+TEST_CASE("randomUniform(arr, lo, hi, seed) throws if lo is greater than hi")
+{
+  // arrange
+  wilt::NArray<double, 1> a(wilt::Point<1>{ 3 }, 0.0);
+
+  // act & assert
+  REQUIRE_THROWS_AS(wilt::randomUniform(a, 1.0, 0.0, 0), std::invalid_argument);
+}
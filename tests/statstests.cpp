@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: statstests.cpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Tests for the opt-in hot-path counters
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// this file is built as its own executable with the counters enabled, since
+// WILT_NARRAY_STATS must be the same in every translation unit of a program
+#define WILT_NARRAY_STATS
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <thread>
+
+#include "../src/wilt-narray/narray.hpp"
+
+TEST_CASE("snapshotStats() counts allocations and clones")
+{
+  // arrange
+  wilt::resetStats();
+  wilt::NArray<int, 2> a({ 4, 5 }, 1);
+
+  // act
+  wilt::NArray<int, 2> b = a.clone();
+  wilt::NArrayStats stats = wilt::snapshotStats();
+
+  // assert
+  REQUIRE(stats.allocations == 2);
+  REQUIRE(stats.allocatedBytes == 40 * sizeof(int));
+  REQUIRE(stats.clones == 1);
+  REQUIRE(stats.clonedBytes == 20 * sizeof(int));
+}
+
+TEST_CASE("snapshotStats() counts views and iterator dereferences")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 4, 5 }, 1);
+  wilt::resetStats();
+
+  // act
+  int sum = 0;
+  for (int value : a.transpose().flipX())
+    sum += value;
+  wilt::NArrayStats stats = wilt::snapshotStats();
+
+  // assert
+  REQUIRE(sum == 20);
+  REQUIRE(stats.allocations == 0);
+  REQUIRE(stats.views == 2);
+  REQUIRE(stats.dereferences == 20);
+}
+
+TEST_CASE("snapshotStats() counts kernels by their condensed dimensionality")
+{
+  // arrange
+  wilt::NArray<int, 3> a({ 4, 5, 6 }, 1);
+  wilt::NArray<int, 3> b({ 4, 5, 6 }, 2);
+  wilt::resetStats();
+
+  // act
+  a += b;
+  a.rangeZ(1, 4).setTo(0);
+  a.rangeY(1, 3).rangeZ(1, 4).foreach([](int&) { });
+  wilt::NArrayStats stats = wilt::snapshotStats();
+
+  // assert
+  REQUIRE(stats.kernels[1] == 1);
+  REQUIRE(stats.kernels[2] == 1);
+  REQUIRE(stats.kernels[3] == 1);
+}
+
+TEST_CASE("snapshotStats() includes counts from threads that have exited")
+{
+  // arrange
+  wilt::resetStats();
+
+  // act
+  std::thread thread([]() { wilt::NArray<int, 1> a(wilt::Point<1>{ 8 }); });
+  thread.join();
+  wilt::NArrayStats stats = wilt::snapshotStats();
+
+  // assert
+  REQUIRE(stats.allocations == 1);
+  REQUIRE(stats.allocatedBytes == 8 * sizeof(int));
+}
+
+TEST_CASE("resetStats() sets all counts to zero")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 4, 5 }, 1);
+  a.clone();
+
+  // act
+  wilt::resetStats();
+  wilt::NArrayStats stats = wilt::snapshotStats();
+
+  // assert
+  REQUIRE(stats.allocations == 0);
+  REQUIRE(stats.clones == 0);
+  REQUIRE(stats.views == 0);
+  REQUIRE(stats.dereferences == 0);
+}
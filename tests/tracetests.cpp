@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+// FILE: tracetests.cpp
+// DATE: 2026-10-18
+// AUTH: Trevor Wilson <kmdreko@gmail.com>
+// DESC: Tests for the optional tracing hooks
+
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Trevor Wilson
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions :
+// 
+//   The above copyright notice and this permission notice shall be included in
+//   all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// built on its own rather than into the main test executable, every
+// translation unit must agree on whether tracing is enabled
+#define WILT_NARRAY_TRACE
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include "../src/wilt-narray/narray.hpp"
+#include "../src/wilt-narray/algorithms.hpp"
+
+namespace
+{
+  struct Record
+  {
+    wilt::NArrayTracePhase phase;
+    std::string name;
+    std::vector<wilt::pos_t> sizes;
+    std::vector<wilt::pos_t> steps;
+    std::size_t elementSize;
+  };
+
+  std::vector<Record> records;
+
+  void record(wilt::NArrayTracePhase phase, const wilt::NArrayTraceEvent& event)
+  {
+    records.push_back({ phase, event.name,
+      std::vector<wilt::pos_t>(event.sizes, event.sizes + event.dims),
+      std::vector<wilt::pos_t>(event.steps, event.steps + event.dims),
+      event.elementSize });
+  }
+}
+
+TEST_CASE("setTraceCallback(callback) reports the start and end of bulk operations")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 3, 4 }, 1);
+  records.clear();
+  wilt::setTraceCallback(record);
+
+  // act
+  a.transpose().setTo(2);
+  wilt::setTraceCallback(nullptr);
+
+  // assert
+  REQUIRE(records.size() == 2);
+  REQUIRE(records[0].phase == wilt::TRACE_BEGIN);
+  REQUIRE(records[1].phase == wilt::TRACE_END);
+  REQUIRE(records[0].name == "setTo");
+  REQUIRE(records[0].sizes == std::vector<wilt::pos_t>{ 4, 3 });
+  REQUIRE(records[0].steps == std::vector<wilt::pos_t>{ 1, 4 });
+  REQUIRE(records[0].elementSize == sizeof(int));
+}
+
+TEST_CASE("setTraceCallback(callback) reports operations in the order they run")
+{
+  // arrange
+  wilt::NArray<int, 1> a(wilt::Point<1>{ 5 }, 3);
+  records.clear();
+  wilt::setTraceCallback(record);
+
+  // act
+  wilt::NArray<int, 1> b = a.clone();
+  wilt::sort(b, 0);
+  b.foreach([](int&) { });
+  b += a;
+  wilt::setTraceCallback(nullptr);
+
+  // assert
+  std::vector<std::string> names;
+  for (const Record& r : records)
+    names.push_back((r.phase == wilt::TRACE_BEGIN ? "+" : "-") + r.name);
+  REQUIRE(names == std::vector<std::string>{ "+clone", "-clone", "+sort", "-sort", "+foreach", "-foreach", "+operator+=", "-operator+=" });
+}
+
+TEST_CASE("setTraceCallback(callback) reports nested operations inside their callers")
+{
+  // arrange
+  wilt::NArray<int, 2> a({ 3, 5 }, 3);
+  records.clear();
+  wilt::setTraceCallback(record);
+
+  // act
+  wilt::median(a, 1);
+  wilt::setTraceCallback(nullptr);
+
+  // assert
+  std::vector<std::string> names;
+  for (const Record& r : records)
+    names.push_back((r.phase == wilt::TRACE_BEGIN ? "+" : "-") + r.name);
+  REQUIRE(names == std::vector<std::string>{ "+median", "+nthElement", "-nthElement", "-median" });
+}
+
+TEST_CASE("setTraceCallback(nullptr) stops tracing")
+{
+  // arrange
+  wilt::NArray<int, 1> a(wilt::Point<1>{ 5 }, 3);
+  records.clear();
+  wilt::setTraceCallback(record);
+  wilt::setTraceCallback(nullptr);
+
+  // act
+  a.setTo(1);
+
+  // assert
+  REQUIRE(records.empty());
+  REQUIRE(wilt::traceCallback() == nullptr);
+}